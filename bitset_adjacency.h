@@ -0,0 +1,204 @@
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "graph_utils.h"
+
+#ifndef AAC_LABORATORIES_BITSET_ADJACENCY_H
+#define AAC_LABORATORIES_BITSET_ADJACENCY_H
+
+// Bit-packed adjacency of the support graph of a multigraph:
+// bit v of row u is set iff edgeMultiplicity(multigraph, u, v) >= minimalMultiplicity (self-loops are never set).
+// With minimalMultiplicity = 1 it is the plain support graph, higher values give the thresholded graphs
+// whose cliques are exactly the complete submultigraphs with alpha >= minimalMultiplicity.
+//
+// Vertex sets are stored the same way (one bit per vertex, wordsPerRow words), so intersecting candidate sets
+// and testing completeness are word-wide AND / popcount operations instead of pair-by-pair matrix lookups.
+
+using BitsetWord = std::uint64_t;
+const int bitsetWordSize = 64;
+
+int popcount64(BitsetWord word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(word);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Index of the lowest set bit, word must not be 0
+int countTrailingZeros64(BitsetWord word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+int bitsetNumWords(int numVertices) {
+    return (numVertices + bitsetWordSize - 1) / bitsetWordSize;
+}
+
+bool bitsetContains(const BitsetWord* bitset, int vertex) {
+    return (bitset[vertex / bitsetWordSize] >> (vertex % bitsetWordSize)) & 1;
+}
+
+void bitsetSet(BitsetWord* bitset, int vertex) {
+    bitset[vertex / bitsetWordSize] |= BitsetWord(1) << (vertex % bitsetWordSize);
+}
+
+void bitsetReset(BitsetWord* bitset, int vertex) {
+    bitset[vertex / bitsetWordSize] &= ~(BitsetWord(1) << (vertex % bitsetWordSize));
+}
+
+int bitsetCount(const BitsetWord* bitset, int numWords) {
+    int count = 0;
+    for (int k = 0; k < numWords; k++) {
+        count += popcount64(bitset[k]);
+    }
+    return count;
+}
+
+// |a ∩ b| without materialising the intersection
+int bitsetCountIntersection(const BitsetWord* a, const BitsetWord* b, int numWords) {
+    int count = 0;
+    for (int k = 0; k < numWords; k++) {
+        count += popcount64(a[k] & b[k]);
+    }
+    return count;
+}
+
+// result = a ∩ b (result may alias a or b)
+void bitsetIntersect(BitsetWord* result, const BitsetWord* a, const BitsetWord* b, int numWords) {
+    for (int k = 0; k < numWords; k++) {
+        result[k] = a[k] & b[k];
+    }
+}
+
+// result = a \ b (result may alias a or b)
+void bitsetDifference(BitsetWord* result, const BitsetWord* a, const BitsetWord* b, int numWords) {
+    for (int k = 0; k < numWords; k++) {
+        result[k] = a[k] & ~b[k];
+    }
+}
+
+bool bitsetIsEmpty(const BitsetWord* bitset, int numWords) {
+    for (int k = 0; k < numWords; k++) {
+        if (bitset[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls function(vertex) for every set bit in increasing order
+template <typename Function>
+void bitsetForEach(const BitsetWord* bitset, int numWords, Function function) {
+    for (int k = 0; k < numWords; k++) {
+        BitsetWord word = bitset[k];
+        while (word) {
+            function(k * bitsetWordSize + countTrailingZeros64(word));
+            word &= word - 1;
+        }
+    }
+}
+
+struct BitsetAdjacency {
+    int numVertices;
+    int wordsPerRow;
+    std::vector<BitsetWord> rows;
+
+    const BitsetWord* operator[](int vertex) const {
+        return rows.data() + (std::size_t)vertex * wordsPerRow;
+    }
+
+    BitsetWord* operator[](int vertex) {
+        return rows.data() + (std::size_t)vertex * wordsPerRow;
+    }
+};
+
+template <typename Multigraph>
+BitsetAdjacency makeBitsetAdjacency(const Multigraph& multigraph, int minimalMultiplicity = 1) {
+    // Time complexity: O(V^2)
+    // Space complexity: O(V^2 / 64)
+
+    int numVertices = multigraph.size();
+    BitsetAdjacency adjacency = {
+        numVertices,
+        bitsetNumWords(numVertices),
+        {}
+    };
+    adjacency.rows.assign((std::size_t)numVertices * adjacency.wordsPerRow, 0);
+
+    for (int u = 0; u < numVertices; u++) {
+        BitsetWord* row = adjacency[u];
+        for (int v = 0; v < numVertices; v++) {
+            if (u != v && edgeMultiplicity(multigraph, u, v) >= minimalMultiplicity) {
+                bitsetSet(row, v);
+            }
+        }
+    }
+
+    return adjacency;
+}
+
+// Every selected vertex is adjacent to all the other selected ones, i.e. selection \ {v} ⊆ N(v) for every v in selection
+bool isSelectionFormCompleteMultigraph(const BitsetAdjacency& adjacency, const BitsetWord* selection) {
+    // Time complexity: O(|selection| * V / 64)
+
+    int numWords = adjacency.wordsPerRow;
+    for (int wordIndex = 0; wordIndex < numWords; wordIndex++) {
+        BitsetWord word = selection[wordIndex];
+        while (word) {
+            int vertex = wordIndex * bitsetWordSize + countTrailingZeros64(word);
+            word &= word - 1;
+
+            const BitsetWord* row = adjacency[vertex];
+            for (int k = 0; k < numWords; k++) {
+                BitsetWord missing = selection[k] & ~row[k];
+                if (k == wordIndex) {
+                    missing &= ~(BitsetWord(1) << (vertex % bitsetWordSize));
+                }
+                if (missing) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Same as isSetOfVerticesFormCompleteMultigraph on the multigraph the adjacency was built from
+bool isSetOfVerticesFormCompleteMultigraph(const BitsetAdjacency& adjacency, const std::vector<int>& vertex_indices, std::vector<BitsetWord>& selectionBuffer) {
+    // Time complexity: O(|selection| * V / 64)
+
+    selectionBuffer.assign(adjacency.wordsPerRow, 0);
+    for (int vertex : vertex_indices) {
+        bitsetSet(selectionBuffer.data(), vertex);
+    }
+
+    return isSelectionFormCompleteMultigraph(adjacency, selectionBuffer.data());
+}
+
+#endif //AAC_LABORATORIES_BITSET_ADJACENCY_H
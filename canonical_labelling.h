@@ -0,0 +1,328 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "graph_utils.h"
+
+#ifndef AAC_LABORATORIES_CANONICAL_LABELLING_H
+#define AAC_LABORATORIES_CANONICAL_LABELLING_H
+
+// Canonical labelling of multigraphs: two multigraphs are isomorphic iff their canonical forms are equal.
+// 1. colour refinement (1-WL): a vertex is recoloured by its colour and the sorted list of
+//    (colour of w, multiplicity v -> w, multiplicity w -> v) over its neighbours w, until the number of colours stops growing.
+//    Colours are numbered by the order of these signatures, so they do not depend on the vertex numbering.
+// 2. individualisation-refinement: while some colour class has several vertices, every vertex of the first smallest one
+//    is given a colour of its own in turn and the colours are refined again. Every discrete colouring is a labelling,
+//    the canonical one is the labelling with the lexicographically smallest relabelled adjacency matrix (the certificate).
+// 3. two labellings with the same certificate differ by an automorphism. The automorphisms found so far skip the
+//    vertices in the same orbit as an already tried one (under the automorphisms fixing the individualised vertices),
+//    and the search jumps back to where the two paths split, since the rest of that branch is an image of an explored one.
+// Refinement alone decides most multigraphs, the search only branches on symmetric ones.
+// Self-loops are part of the multigraph unless countSelfLoops is false (graphEditDistance ignores them).
+
+struct CanonicalForm {
+    int numVertices;
+    // labelling[v] is the canonical position of the vertex v
+    std::vector<int> labelling;
+    // Adjacency matrix in the canonical order, row by row
+    std::vector<int> certificate;
+};
+
+struct CanonicalHash {
+    std::uint64_t low;
+    std::uint64_t high;
+};
+
+bool operator==(const CanonicalHash& a, const CanonicalHash& b) {
+    return a.low == b.low && a.high == b.high;
+}
+
+bool operator<(const CanonicalHash& a, const CanonicalHash& b) {
+    return a.high != b.high ? a.high < b.high : a.low < b.low;
+}
+
+struct CanonicalLabellingSearch {
+    int numVertices;
+    // Adjacency matrix row by row, the diagonal is 0 when self-loops are not counted
+    std::vector<int> matrix;
+
+    bool hasBest;
+    std::vector<int> bestCertificate;
+    std::vector<int> bestLabelling;
+    std::vector<int> bestPath;
+
+    // Individualised vertices from the root down to the current node
+    std::vector<int> path;
+    // automorphisms[k][v] is the image of v
+    std::vector<std::vector<int>> automorphisms;
+    // Depth to return to after an automorphism was found, numVertices + 1 when none
+    int backjumpDepth;
+};
+
+// Refines colours (any integers) into an equitable colouring numbered 0..count - 1, returns the number of colours
+int refineCanonicalColours(const CanonicalLabellingSearch& search, std::vector<int>& colours) {
+    // Time complexity: O(rounds * (V^2 + V d log d + V log V * d)), rounds <= V
+
+    int numVertices = search.numVertices;
+    std::vector<int> order(numVertices);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<std::vector<std::tuple<int, int, int>>> signatures(numVertices);
+    std::vector<int> previousColours = colours;
+
+    auto isSignatureLess = [&previousColours, &signatures](int a, int b) {
+        if (previousColours[a] != previousColours[b]) {
+            return previousColours[a] < previousColours[b];
+        }
+        return signatures[a] < signatures[b];
+    };
+
+    // The first round only numbers the given colours
+    bool isFirstRound = true;
+    int numColours = -1;
+
+    while (true) {
+        if (!isFirstRound) {
+            for (int v = 0; v < numVertices; v++) {
+                std::vector<std::tuple<int, int, int>>& signature = signatures[v];
+                signature.clear();
+                const int* row = &search.matrix[(size_t)v * numVertices];
+                for (int w = 0; w < numVertices; w++) {
+                    int inMultiplicity = search.matrix[(size_t)w * numVertices + v];
+                    if (w != v && (row[w] != 0 || inMultiplicity != 0)) {
+                        signature.emplace_back(previousColours[w], row[w], inMultiplicity);
+                    }
+                }
+                std::sort(signature.begin(), signature.end());
+            }
+        }
+
+        std::sort(order.begin(), order.end(), isSignatureLess);
+
+        int nextNumColours = 0;
+        for (int k = 0; k < numVertices; k++) {
+            if (k > 0 && isSignatureLess(order[k - 1], order[k])) {
+                nextNumColours++;
+            }
+            colours[order[k]] = nextNumColours;
+        }
+        nextNumColours += numVertices > 0 ? 1 : 0;
+
+        if (nextNumColours == numColours || nextNumColours == numVertices) {
+            return nextNumColours;
+        }
+
+        numColours = nextNumColours;
+        previousColours = colours;
+        isFirstRound = false;
+    }
+}
+
+// Is v in the same orbit as one of the tried vertices, under the known automorphisms fixing the path?
+bool isInTriedOrbit(const CanonicalLabellingSearch& search, int v, const std::vector<int>& tried) {
+    // Time complexity: O(automorphisms * V)
+
+    std::vector<int> parent(search.numVertices);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int x) {
+        while (parent[x] != x) {
+            x = parent[x] = parent[parent[x]];
+        }
+        return x;
+    };
+
+    for (auto& automorphism : search.automorphisms) {
+        bool fixesPath = true;
+        for (int w : search.path) {
+            if (automorphism[w] != w) {
+                fixesPath = false;
+                break;
+            }
+        }
+        if (!fixesPath) {
+            continue;
+        }
+
+        for (int w = 0; w < search.numVertices; w++) {
+            parent[find(w)] = find(automorphism[w]);
+        }
+    }
+
+    for (int t : tried) {
+        if (find(t) == find(v)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void canonicalLabellingLeaf(CanonicalLabellingSearch& search, const std::vector<int>& labelling) {
+    int numVertices = search.numVertices;
+
+    std::vector<int> certificate((size_t)numVertices * numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        for (int w = 0; w < numVertices; w++) {
+            certificate[(size_t)labelling[v] * numVertices + labelling[w]] = search.matrix[(size_t)v * numVertices + w];
+        }
+    }
+
+    if (!search.hasBest || certificate < search.bestCertificate) {
+        search.hasBest = true;
+        search.bestCertificate = std::move(certificate);
+        search.bestLabelling = labelling;
+        search.bestPath = search.path;
+        return;
+    }
+
+    if (certificate != search.bestCertificate) {
+        return;
+    }
+
+    // Same certificate: v and the vertex at the same position of the best labelling are exchanged by an automorphism
+    std::vector<int> bestVertexAt(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        bestVertexAt[search.bestLabelling[v]] = v;
+    }
+    std::vector<int> automorphism(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        automorphism[bestVertexAt[labelling[v]]] = v;
+    }
+    search.automorphisms.push_back(std::move(automorphism));
+
+    int splitDepth = 0;
+    while (splitDepth < (int)search.path.size() && splitDepth < (int)search.bestPath.size() && search.path[splitDepth] == search.bestPath[splitDepth]) {
+        splitDepth++;
+    }
+    search.backjumpDepth = splitDepth;
+}
+
+void canonicalLabellingHelper(CanonicalLabellingSearch& search, const std::vector<int>& colours, int numColours) {
+    int numVertices = search.numVertices;
+
+    if (numColours == numVertices) {
+        canonicalLabellingLeaf(search, colours);
+        return;
+    }
+
+    // First smallest colour class with more than one vertex
+    std::vector<int> classSizes(numColours, 0);
+    for (int v = 0; v < numVertices; v++) {
+        classSizes[colours[v]]++;
+    }
+    int targetColour = -1;
+    for (int colour = 0; colour < numColours; colour++) {
+        if (classSizes[colour] > 1 && (targetColour == -1 || classSizes[colour] < classSizes[targetColour])) {
+            targetColour = colour;
+        }
+    }
+
+    int depth = search.path.size();
+    std::vector<int> tried;
+    std::vector<int> childColours(numVertices);
+
+    for (int v = 0; v < numVertices; v++) {
+        if (colours[v] != targetColour || isInTriedOrbit(search, v, tried)) {
+            continue;
+        }
+        tried.push_back(v);
+
+        // v goes first in its class
+        for (int w = 0; w < numVertices; w++) {
+            childColours[w] = 2 * colours[w] + (w == v ? 0 : 1);
+        }
+        int childNumColours = refineCanonicalColours(search, childColours);
+
+        search.path.push_back(v);
+        canonicalLabellingHelper(search, childColours, childNumColours);
+        search.path.pop_back();
+
+        if (search.backjumpDepth < depth) {
+            return;
+        }
+        search.backjumpDepth = numVertices + 1;
+    }
+}
+
+template <typename Multigraph>
+CanonicalForm canonicalForm(const Multigraph& multigraph, bool countSelfLoops = true) {
+    // Time complexity: O(V^3 log V) when refinement decides, exponential in the worst case (highly regular multigraphs)
+    // Space complexity: O(V^2 + automorphisms * V)
+
+    int numVertices = multigraph.size();
+
+    CanonicalLabellingSearch search;
+    search.numVertices = numVertices;
+    search.matrix.assign((size_t)numVertices * numVertices, 0);
+    for (int v = 0; v < numVertices; v++) {
+        for (int w = 0; w < numVertices; w++) {
+            if (v != w || countSelfLoops) {
+                search.matrix[(size_t)v * numVertices + w] = multigraph[v][w];
+            }
+        }
+    }
+    search.hasBest = false;
+    search.backjumpDepth = numVertices + 1;
+
+    // Start from the self-loops, the only vertex label a multigraph has
+    std::vector<int> colours(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        colours[v] = search.matrix[(size_t)v * numVertices + v];
+    }
+    int numColours = refineCanonicalColours(search, colours);
+
+    canonicalLabellingHelper(search, colours, numColours);
+
+    return {
+        numVertices,
+        search.bestLabelling,
+        search.bestCertificate
+    };
+}
+
+// 128 bits of the certificate (two 64-bit hashes with different seeds), low alone is the 64-bit hash
+CanonicalHash canonicalHash(const CanonicalForm& form) {
+    // Time complexity: O(V^2)
+
+    // splitmix64 finaliser
+    auto mix = [](std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    };
+
+    std::uint64_t low = mix(form.numVertices);
+    std::uint64_t high = mix(low ^ 0x6a09e667f3bcc909ULL);
+    for (int value : form.certificate) {
+        low = mix(low ^ (std::uint32_t)value);
+        high = mix(high + (std::uint32_t)value * 0xc2b2ae3d27d4eb4fULL);
+    }
+
+    return {low, high};
+}
+
+// 32 hex digits, high half first
+std::string canonicalHashString(const CanonicalHash& hash) {
+    char buffer[33];
+    std::snprintf(buffer, sizeof(buffer), "%016llx%016llx", (unsigned long long)hash.high, (unsigned long long)hash.low);
+    return buffer;
+}
+
+template <typename Multigraph>
+bool areMultigraphsIsomorphic(const Multigraph& multigraph1, const Multigraph& multigraph2, bool countSelfLoops = true) {
+    // Time complexity: as canonicalForm
+
+    if (multigraph1.size() != multigraph2.size()) {
+        return false;
+    }
+
+    return canonicalForm(multigraph1, countSelfLoops).certificate == canonicalForm(multigraph2, countSelfLoops).certificate;
+}
+
+#endif //AAC_LABORATORIES_CANONICAL_LABELLING_H
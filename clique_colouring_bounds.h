@@ -0,0 +1,230 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "graph_utils.h"
+#include "bitset_adjacency.h"
+
+#ifndef AAC_LABORATORIES_CLIQUE_COLOURING_BOUNDS_H
+#define AAC_LABORATORIES_CLIQUE_COLOURING_BOUNDS_H
+
+// Upper bounds on the size of a clique inside a candidate set of the support graph.
+// Every vertex of a clique needs its own colour in any proper colouring, so the number of colours
+// of any colouring of the candidates bounds the clique from above.
+// 1. greedy sequential colouring: cheap enough to run at every node of a branch and bound
+// 2. DSATUR: colours the most constrained vertex first, usually fewer colours, for one-off bounds
+// 3. degree bound: a clique of k vertices needs k vertices of degree at least k - 1
+
+// Greedy sequential colouring of the candidates: colour classes are built one by one,
+// each taking the lowest remaining candidates not adjacent to the class so far.
+// order receives the candidates class by class and colours their colours (non-decreasing, starting at 1).
+// uncoloured and colourClass are scratch bitsets of wordsPerRow words.
+// Returns the number of colours.
+int greedyColouring(const BitsetAdjacency& adjacency, const BitsetWord* candidates, BitsetWord* uncoloured, BitsetWord* colourClass, std::vector<int>& order, std::vector<int>& colours) {
+    // Time complexity: O(|P| * V / 64) per colour class
+
+    int numWords = adjacency.wordsPerRow;
+    order.clear();
+    colours.clear();
+
+    for (int k = 0; k < numWords; k++) {
+        uncoloured[k] = candidates[k];
+    }
+
+    int colour = 0;
+    while (!bitsetIsEmpty(uncoloured, numWords)) {
+        colour++;
+        for (int k = 0; k < numWords; k++) {
+            colourClass[k] = uncoloured[k];
+        }
+
+        for (int k = 0; k < numWords; k++) {
+            while (colourClass[k]) {
+                int vertex = k * bitsetWordSize + countTrailingZeros64(colourClass[k]);
+
+                bitsetReset(uncoloured, vertex);
+                bitsetReset(colourClass, vertex);
+                bitsetDifference(colourClass, colourClass, adjacency[vertex], numWords);
+
+                order.push_back(vertex);
+                colours.push_back(colour);
+            }
+        }
+    }
+
+    return colour;
+}
+
+// Number of colours of the greedy sequential colouring, without keeping the colouring.
+// uncoloured and colourClass are scratch bitsets of wordsPerRow words.
+int greedyColouringBound(const BitsetAdjacency& adjacency, const BitsetWord* candidates, BitsetWord* uncoloured, BitsetWord* colourClass) {
+    // Time complexity: O(|P| * V / 64) per colour class
+
+    int numWords = adjacency.wordsPerRow;
+    for (int k = 0; k < numWords; k++) {
+        uncoloured[k] = candidates[k];
+    }
+
+    int colour = 0;
+    while (!bitsetIsEmpty(uncoloured, numWords)) {
+        colour++;
+        for (int k = 0; k < numWords; k++) {
+            colourClass[k] = uncoloured[k];
+        }
+
+        for (int k = 0; k < numWords; k++) {
+            while (colourClass[k]) {
+                int vertex = k * bitsetWordSize + countTrailingZeros64(colourClass[k]);
+
+                bitsetReset(uncoloured, vertex);
+                bitsetReset(colourClass, vertex);
+                bitsetDifference(colourClass, colourClass, adjacency[vertex], numWords);
+            }
+        }
+    }
+
+    return colour;
+}
+
+// DSATUR (Brelaz): repeatedly colour the uncoloured candidate with the most distinct colours among its
+// neighbours (ties: the most uncoloured neighbours) with the smallest colour not used by them.
+// Returns the number of colours.
+int dsaturColouringBound(const BitsetAdjacency& adjacency, const BitsetWord* candidates) {
+    // Time complexity: O(|P|^2 + |P| * V / 64 + E(P))
+    // Space complexity: O(|P|^2 / 64)
+
+    int numWords = adjacency.wordsPerRow;
+
+    std::vector<int> vertices;
+    bitsetForEach(candidates, numWords, [&vertices](int vertex) {
+        vertices.push_back(vertex);
+    });
+
+    int numCandidates = vertices.size();
+    if (numCandidates == 0) {
+        return 0;
+    }
+
+    std::vector<int> position(adjacency.numVertices, -1);
+    for (int i = 0; i < numCandidates; i++) {
+        position[vertices[i]] = i;
+    }
+
+    // Neighbours inside the candidate set, as positions
+    std::vector<std::vector<int>> neighbours(numCandidates);
+    for (int i = 0; i < numCandidates; i++) {
+        const BitsetWord* row = adjacency[vertices[i]];
+        for (int k = 0; k < numWords; k++) {
+            BitsetWord word = row[k] & candidates[k];
+            while (word) {
+                neighbours[i].push_back(position[k * bitsetWordSize + countTrailingZeros64(word)]);
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Colours used around every candidate, at most numCandidates colours are ever needed
+    int colourWords = bitsetNumWords(numCandidates + 1);
+    std::vector<BitsetWord> neighbourColours((size_t)numCandidates * colourWords, 0);
+    std::vector<int> saturation(numCandidates, 0);
+    std::vector<int> uncolouredDegree(numCandidates);
+    std::vector<int> colour(numCandidates, 0);
+    for (int i = 0; i < numCandidates; i++) {
+        uncolouredDegree[i] = neighbours[i].size();
+    }
+
+    int numColours = 0;
+    for (int step = 0; step < numCandidates; step++) {
+        int selected = -1;
+        for (int i = 0; i < numCandidates; i++) {
+            if (colour[i] != 0) {
+                continue;
+            }
+            if (
+                selected == -1
+                || saturation[i] > saturation[selected]
+                || (saturation[i] == saturation[selected] && uncolouredDegree[i] > uncolouredDegree[selected])
+            ) {
+                selected = i;
+            }
+        }
+
+        // Smallest colour (from 1) not used by the neighbours
+        const BitsetWord* usedColours = &neighbourColours[(size_t)selected * colourWords];
+        int selectedColour = 1;
+        while (bitsetContains(usedColours, selectedColour)) {
+            selectedColour++;
+        }
+
+        colour[selected] = selectedColour;
+        numColours = std::max(numColours, selectedColour);
+
+        for (int neighbour : neighbours[selected]) {
+            if (colour[neighbour] != 0) {
+                continue;
+            }
+
+            uncolouredDegree[neighbour]--;
+            BitsetWord* neighbourUsedColours = &neighbourColours[(size_t)neighbour * colourWords];
+            if (!bitsetContains(neighbourUsedColours, selectedColour)) {
+                bitsetSet(neighbourUsedColours, selectedColour);
+                saturation[neighbour]++;
+            }
+        }
+    }
+
+    return numColours;
+}
+
+// Largest k such that at least k vertices have at least k - 1 neighbours
+int degreeCliqueBound(const BitsetAdjacency& adjacency) {
+    // Time complexity: O(V^2 / 64 + V log V)
+
+    int numVertices = adjacency.numVertices;
+    std::vector<int> degrees(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        degrees[i] = bitsetCount(adjacency[i], adjacency.wordsPerRow);
+    }
+    std::sort(degrees.begin(), degrees.end(), std::greater<int>());
+
+    int bound = 0;
+    while (bound < numVertices && degrees[bound] >= bound) {
+        bound++;
+    }
+
+    return bound;
+}
+
+// Upper bound on the number of vertices of a complete submultigraph: the best of the degree and DSATUR bounds.
+// Together with a clique found by a heuristic it certifies how far the heuristic can be from the optimum.
+template <typename Multigraph>
+int maximalCliqueSizeUpperBound(const Multigraph& multigraph) {
+    // Time complexity: O(V^2)
+
+    BitsetAdjacency adjacency = makeBitsetAdjacency(multigraph);
+
+    std::vector<BitsetWord> allVertices(adjacency.wordsPerRow, 0);
+    for (int vertex = 0; vertex < adjacency.numVertices; vertex++) {
+        bitsetSet(allVertices.data(), vertex);
+    }
+
+    int bound = std::min(degreeCliqueBound(adjacency), dsaturColouringBound(adjacency, allVertices.data()));
+
+    // A complete multigraph has at least 2 vertices, a graph without edges has none
+    return bound < 2 ? 0 : bound;
+}
+
+// Prints the bound and how many vertices the found clique can be short of the largest one.
+// The gap is never negative: the heuristics report a single vertex on a multigraph without edges, where the bound is 0.
+template <typename Multigraph>
+void printCliqueOptimalityGap(const Multigraph& multigraph, const CliqueAlgorithmResult& clique) {
+    // Time complexity: O(V^2)
+
+    int cliqueSizeUpperBound = maximalCliqueSizeUpperBound(multigraph);
+    int optimalityGap = std::max(0, cliqueSizeUpperBound - clique.completeMultigraph.n);
+    std::cout << "Clique size upper bound: " << cliqueSizeUpperBound
+        << " (optimality gap: at most " << optimalityGap << " vertices)" << std::endl;
+}
+
+#endif //AAC_LABORATORIES_CLIQUE_COLOURING_BOUNDS_H
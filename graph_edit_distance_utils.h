@@ -0,0 +1,195 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cstdlib>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "simd_kernels.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_EDIT_DISTANCE_UTILS_H
+#define AAC_LABORATORIES_GRAPH_EDIT_DISTANCE_UTILS_H
+
+// Shared pieces of the graph edit distance solvers.
+// All of them use the cost model of graphEditDistance (graph_solution_2.h):
+//   GED = |V1 - V2| + min over vertex mappings p of sum over i < j of |multigraph1[p(i)][p(j)] - multigraph2[i][j]|
+// where the smaller multigraph is padded with isolated vertices and self-loops are ignored.
+// A mapping is stored as a permutation: permutation[i] is the vertex of the 1st multigraph mapped onto the vertex i of the 2nd one.
+
+struct PaddedMultigraphPair {
+    DenseMultigraph<int> multigraph1;
+    DenseMultigraph<int> multigraph2;
+    int numVertices;
+    int vertexCountDifference;
+};
+
+// Copy both multigraphs into dense int matrices of the same (maximal) size
+template <typename Multigraph>
+PaddedMultigraphPair makePaddedMultigraphPair(const Multigraph& multigraph1, const Multigraph& multigraph2) {
+    // Time complexity: O(V^2)
+
+    int numVertices1 = multigraph1.size();
+    int numVertices2 = multigraph2.size();
+    int maxNumVertices = std::max(numVertices1, numVertices2);
+
+    return {
+        toDenseMultigraph<int>(multigraph1, maxNumVertices),
+        toDenseMultigraph<int>(multigraph2, maxNumVertices),
+        maxNumVertices,
+        std::abs(numVertices1 - numVertices2)
+    };
+}
+
+// Edges edit distance of a single mapping (without the vertex count difference)
+int graphEditDistanceMappingCost(const PaddedMultigraphPair& multigraphs, const std::vector<int>& permutation) {
+    // Time complexity: O(V^2), row by row with the SIMD kernel (simd_kernels.h)
+
+    int numVertices = multigraphs.numVertices;
+    int edgesEditDistance = 0;
+
+    for (int i = 0; i < numVertices; i++) {
+        edgesEditDistance += permutedAbsoluteDifferenceSum(
+            multigraphs.multigraph1[permutation[i]],
+            permutation.data(),
+            multigraphs.multigraph2[i],
+            i + 1,
+            numVertices
+        );
+    }
+
+    return edgesEditDistance;
+}
+
+// Change of graphEditDistanceMappingCost after swapping permutation[a] and permutation[b].
+// Only the pairs touching a or b change, so it is O(V) instead of O(V^2).
+// The sum over all k runs through the fused SIMD kernel (simd_kernels.h), the terms of k = a and k = b are taken back out.
+int graphEditDistanceSwapDelta(const PaddedMultigraphPair& multigraphs, const std::vector<int>& permutation, int a, int b) {
+    // Time complexity: O(V)
+
+    int numVertices = multigraphs.numVertices;
+    int firstGraphA = permutation[a];
+    int firstGraphB = permutation[b];
+
+    const int* firstGraphRowA = multigraphs.multigraph1[firstGraphA];
+    const int* firstGraphRowB = multigraphs.multigraph1[firstGraphB];
+    const int* secondGraphRowA = multigraphs.multigraph2[a];
+    const int* secondGraphRowB = multigraphs.multigraph2[b];
+
+    int delta = swapDeltaSum(firstGraphRowA, firstGraphRowB, permutation.data(), secondGraphRowA, secondGraphRowB, 0, numVertices)
+        - swapDeltaSumScalar(firstGraphRowA, firstGraphRowB, permutation.data(), secondGraphRowA, secondGraphRowB, a, a + 1)
+        - swapDeltaSumScalar(firstGraphRowA, firstGraphRowB, permutation.data(), secondGraphRowA, secondGraphRowB, b, b + 1);
+
+    delta += std::abs(firstGraphRowB[firstGraphA] - secondGraphRowA[b]) - std::abs(firstGraphRowA[firstGraphB] - secondGraphRowA[b]);
+
+    return delta;
+}
+
+// Improve a mapping by swapping pairs of vertices while it helps (first improvement).
+// Returns the new edges edit distance of the mapping.
+int improveMappingBySwaps(const PaddedMultigraphPair& multigraphs, std::vector<int>& permutation, int cost) {
+    // Time complexity: O(V^3) per round
+
+    int numVertices = multigraphs.numVertices;
+    bool hasImproved = true;
+
+    while (hasImproved) {
+        hasImproved = false;
+        for (int a = 0; a < numVertices; a++) {
+            for (int b = a + 1; b < numVertices; b++) {
+                int delta = graphEditDistanceSwapDelta(multigraphs, permutation, a, b);
+                if (delta < 0) {
+                    std::swap(permutation[a], permutation[b]);
+                    cost += delta;
+                    hasImproved = true;
+                }
+            }
+        }
+    }
+
+    return cost;
+}
+
+// Degrees without self-loops
+std::vector<int> offDiagonalDegrees(const DenseMultigraph<int>& multigraph) {
+    // Time complexity: O(V^2)
+
+    int numVertices = multigraph.size();
+    std::vector<int> degrees(numVertices, 0);
+
+    for (int i = 0; i < numVertices; i++) {
+        const int* row = multigraph[i];
+        for (int j = 0; j < numVertices; j++) {
+            if (i != j) {
+                degrees[i] += row[j];
+            }
+        }
+    }
+
+    return degrees;
+}
+
+// Sum of |a_k - b_k| over both degree lists sorted in the same order.
+// It is the minimal value of sum over i of |degrees1[p(i)] - degrees2[i]| over all bijections p.
+// The lists are sorted in place.
+int sortedDegreesDistance(std::vector<int>& degrees1, std::vector<int>& degrees2) {
+    // Time complexity: O(V log V)
+
+    std::sort(degrees1.begin(), degrees1.end(), std::greater<int>());
+    std::sort(degrees2.begin(), degrees2.end(), std::greater<int>());
+
+    int distance = 0;
+    for (int k = 0; k < (int)degrees1.size(); k++) {
+        distance += std::abs(degrees1[k] - degrees2[k]);
+    }
+
+    return distance;
+}
+
+// Admissible lower bound on the edges edit distance based on the degree sequences
+// (the same idea as graphEditDistancePolynomialApproximation).
+// For any mapping, sum over i of |deg1(p(i)) - deg2(i)| <= sum over i, j of |multigraph1[p(i)][p(j)] - multigraph2[i][j]|,
+// and the right side counts every pair twice, so half of the sorted degrees distance never overestimates.
+int graphEditDistanceDegreeSequenceLowerBound(const PaddedMultigraphPair& multigraphs) {
+    // Time complexity: O(V^2)
+
+    std::vector<int> degrees1 = offDiagonalDegrees(multigraphs.multigraph1);
+    std::vector<int> degrees2 = offDiagonalDegrees(multigraphs.multigraph2);
+
+    return (sortedDegreesDistance(degrees1, degrees2) + 1) / 2;
+}
+
+// Mapping that pairs vertices with the same rank in the degree sequences.
+// Cheap starting upper bound for the exact solvers.
+std::vector<int> degreeSequenceMapping(const PaddedMultigraphPair& multigraphs) {
+    // Time complexity: O(V^2)
+
+    int numVertices = multigraphs.numVertices;
+    std::vector<int> degrees1 = offDiagonalDegrees(multigraphs.multigraph1);
+    std::vector<int> degrees2 = offDiagonalDegrees(multigraphs.multigraph2);
+
+    std::vector<int> order1(numVertices);
+    std::vector<int> order2(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        order1[i] = i;
+        order2[i] = i;
+    }
+
+    std::stable_sort(order1.begin(), order1.end(), [&degrees1](int a, int b) {
+        return degrees1[a] > degrees1[b];
+    });
+    std::stable_sort(order2.begin(), order2.end(), [&degrees2](int a, int b) {
+        return degrees2[a] > degrees2[b];
+    });
+
+    std::vector<int> permutation(numVertices);
+    for (int k = 0; k < numVertices; k++) {
+        permutation[order2[k]] = order1[k];
+    }
+
+    return permutation;
+}
+
+#endif //AAC_LABORATORIES_GRAPH_EDIT_DISTANCE_UTILS_H
@@ -12,80 +12,179 @@
 #include <algorithm>
 #include <random>
 #include <limits>
+#include <atomic>
 
 #include "graph_utils.h"
+#include "graph_edit_distance_utils.h"
+#include "thread_pool.h"
 
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_2_H
 
-int graphEditDistance(const MultigraphAdjacencyMatrix& multigraph1, const MultigraphAdjacencyMatrix& multigraph2) {
-    // Time complexity: O(V^2 * V!)
+// Minimal edges edit distance over all permutations that keep permutation[0..fixedPositions - 1] in place.
+// edgesEditDistance is the cost of the given permutation.
+// Stops early when a zero-cost mapping is found here or, if given, by another worker.
+int graphEditDistanceOverSuffixPermutations(
+    const PaddedMultigraphPair& multigraphs,
+    std::vector<int>& permutation,
+    int fixedPositions,
+    int edgesEditDistance,
+    const std::atomic<int>* sharedMinEdgesEditDistance = nullptr
+) {
+    // Time complexity: O(V * (V - fixedPositions)!)
+
+    int numFreePositions = multigraphs.numVertices - fixedPositions;
+    int minEdgesEditDistance = edgesEditDistance;
+
+    // Heap's algorithm: every next permutation differs from the previous one by a single swap,
+    // so the cost is updated by the O(V) delta of that swap instead of being recomputed
+    std::vector<int> swapCounters(numFreePositions, 0);
+    int position = 1;
+    while (position < numFreePositions && minEdgesEditDistance > 0) {
+        if (swapCounters[position] < position) {
+            int swapWith = position % 2 == 0 ? 0 : swapCounters[position];
+
+            edgesEditDistance += graphEditDistanceSwapDelta(multigraphs, permutation, fixedPositions + swapWith, fixedPositions + position);
+            std::swap(permutation[fixedPositions + swapWith], permutation[fixedPositions + position]);
+
+            if (edgesEditDistance < minEdgesEditDistance) {
+                minEdgesEditDistance = edgesEditDistance;
+            }
+
+            if (sharedMinEdgesEditDistance != nullptr && sharedMinEdgesEditDistance->load(std::memory_order_relaxed) == 0) {
+                break;
+            }
+
+            swapCounters[position]++;
+            position = 1;
+        } else {
+            swapCounters[position] = 0;
+            position++;
+        }
+    }
+
+    return minEdgesEditDistance;
+}
 
-    auto size1 = size(multigraph1);
-    auto size2 = size(multigraph2);
+template <typename Multigraph>
+int graphEditDistance(const Multigraph& multigraph1, const Multigraph& multigraph2) {
+    // Time complexity: O(V * V!)
 
-    int maxNumVertices = std::max(size1.numVertices, size2.numVertices);
+    // The smaller multigraph is padded with isolated vertices (if the vertex is not present, its degree is 0)
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+
+    int maxNumVertices = multigraphs.numVertices;
     int editDistance = 0;
 
     // If the number of vertices is different, then the edit distance is the difference between the number of vertices
-    editDistance += std::abs(size1.numVertices - size2.numVertices);
+    editDistance += multigraphs.vertexCountDifference;
 
     // For all permutations from 0 to maxNumVertices - 1
     // Find the permutation that minimizes the graph edit distance
-    int minEdgesEditDistance = std::numeric_limits<int>::max();
-
+    // Assume 1st graph is the one being edited into the 2nd graph. We permute the 1st graph mappings.
     std::vector<int> permutation(maxNumVertices);
     for (int i = 0; i < maxNumVertices; i++) {
         permutation[i] = i;
     }
 
-    do {
-        int edgesEditDistance = 0;
-        for (int i = 0; i < maxNumVertices; i++) {
-            for (int j = i; j < maxNumVertices; j++) {
-                if (i == j) {
-                    continue;
-                }
+    // Only the first permutation is evaluated from scratch in O(V^2)
+    int edgesEditDistance = graphEditDistanceMappingCost(multigraphs, permutation);
 
-                // Assume 1st graph is the one being edited into the 2nd graph. We permute the 1st graph mappings.
-                int firstGraphI = permutation[i];
-                int firstGraphJ = permutation[j];
+    editDistance += graphEditDistanceOverSuffixPermutations(multigraphs, permutation, 0, edgesEditDistance);
+    return editDistance;
+}
 
-                // If the vertex is not present in the 1st graph, then its degree is 0.
-                int vertex1Degree = 0;
-                if (firstGraphI < size1.numVertices && firstGraphJ < size1.numVertices) {
-                    vertex1Degree = multigraph1[firstGraphI][firstGraphJ];
-                }
+// One piece of the parallel search: permutation[0..fixedPositions - 1] is fixed and prefixEditDistance is the cost of the pairs inside that prefix.
+// Short prefixes are split further into one task per choice of the next position, long enough ones are enumerated.
+void graphEditDistanceParallelTask(
+    const PaddedMultigraphPair& multigraphs,
+    WorkStealingThreadPool& threadPool,
+    std::atomic<int>& sharedMinEdgesEditDistance,
+    std::vector<int> permutation,
+    int fixedPositions,
+    int splitPositions,
+    int prefixEditDistance
+) {
+    // The pairs outside the prefix cost >= 0, so the prefix cost alone may already rule this piece out
+    if (prefixEditDistance >= sharedMinEdgesEditDistance.load()) {
+        return;
+    }
 
-                int secondGraphI = i;
-                int secondGraphJ = j;
+    int maxNumVertices = multigraphs.numVertices;
 
-                int vertex2Degree = 0;
-                if (secondGraphI < size2.numVertices && secondGraphJ < size2.numVertices) {
-                    vertex2Degree = multigraph2[secondGraphI][secondGraphJ];
-                }
+    if (fixedPositions < splitPositions) {
+        const int* secondGraphRow = multigraphs.multigraph2[fixedPositions];
 
-//                std::cout << "Vertex 1 degree: " << vertex1Degree << " Vertex 2 degree: " << vertex2Degree << std::endl;
+        for (int candidate = fixedPositions; candidate < maxNumVertices; candidate++) {
+            std::vector<int> nextPermutation = permutation;
+            std::swap(nextPermutation[fixedPositions], nextPermutation[candidate]);
 
-                edgesEditDistance += std::abs(vertex1Degree - vertex2Degree);
+            const int* firstGraphRow = multigraphs.multigraph1[nextPermutation[fixedPositions]];
+            int nextPrefixEditDistance = prefixEditDistance;
+            for (int j = 0; j < fixedPositions; j++) {
+                nextPrefixEditDistance += std::abs(firstGraphRow[nextPermutation[j]] - secondGraphRow[j]);
             }
+
+            threadPool.submit([&multigraphs, &threadPool, &sharedMinEdgesEditDistance, nextPermutation, fixedPositions, splitPositions, nextPrefixEditDistance]() {
+                graphEditDistanceParallelTask(
+                    multigraphs,
+                    threadPool,
+                    sharedMinEdgesEditDistance,
+                    nextPermutation,
+                    fixedPositions + 1,
+                    splitPositions,
+                    nextPrefixEditDistance
+                );
+            });
         }
+        return;
+    }
 
-//        std::cout << "Permutation: ";
-//        for (int i = 0; i < maxNumVertices; i++) {
-//            std::cout << permutation[i] << " ";
-//        }
-//        std::cout << "Edges edit distance: " << edgesEditDistance << std::endl;
-//        std::cout << "Min edges edit distance: " << minEdgesEditDistance << std::endl;
-//        std::cout << std::endl;
+    int edgesEditDistance = graphEditDistanceMappingCost(multigraphs, permutation);
+    int minEdgesEditDistance = graphEditDistanceOverSuffixPermutations(
+        multigraphs,
+        permutation,
+        fixedPositions,
+        edgesEditDistance,
+        &sharedMinEdgesEditDistance
+    );
 
-        if (edgesEditDistance < minEdgesEditDistance) {
-            minEdgesEditDistance = edgesEditDistance;
-        }
-    } while (std::next_permutation(permutation.begin(), permutation.end()));
+    atomicMin(sharedMinEdgesEditDistance, minEdgesEditDistance);
+}
 
-    editDistance += minEdgesEditDistance;
-    return editDistance;
+// Same result as graphEditDistance, with the permutation space split by its leading positions between threads.
+// The best cost found so far is shared, so prefixes that already cost more are skipped.
+template <typename Multigraph>
+int graphEditDistanceParallel(const Multigraph& multigraph1, const Multigraph& multigraph2, int threadCount) {
+    // Time complexity: O(V * V! / threadCount)
+
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    int maxNumVertices = multigraphs.numVertices;
+
+    std::vector<int> permutation(maxNumVertices);
+    for (int i = 0; i < maxNumVertices; i++) {
+        permutation[i] = i;
+    }
+
+    // Fix enough leading positions to get several pieces per thread, so stealing can balance them
+    int splitPositions = 0;
+    long long numPieces = 1;
+    while (splitPositions < maxNumVertices - 1 && numPieces < 16LL * threadCount) {
+        numPieces *= maxNumVertices - splitPositions;
+        splitPositions++;
+    }
+
+    std::atomic<int> sharedMinEdgesEditDistance(graphEditDistanceMappingCost(multigraphs, permutation));
+
+    {
+        WorkStealingThreadPool threadPool(threadCount);
+        threadPool.submit([&multigraphs, &threadPool, &sharedMinEdgesEditDistance, permutation, splitPositions]() {
+            graphEditDistanceParallelTask(multigraphs, threadPool, sharedMinEdgesEditDistance, permutation, 0, splitPositions, 0);
+        });
+        threadPool.wait();
+    }
+
+    return multigraphs.vertexCountDifference + sharedMinEdgesEditDistance.load();
 }
 
 #endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_H
@@ -0,0 +1,272 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "graph_edit_distance_utils.h"
+#include "linear_assignment.h"
+#include "graph_solution_2_branch_and_bound.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_A_STAR_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_A_STAR_H
+
+// Exact graph edit distance by A* over partial vertex mappings, with a memory cap and an optional time limit.
+// The nodes are the ones of graphEditDistanceBranchAndBound (graph_solution_2_branch_and_bound.h): a node maps one more
+// vertex of the 2nd multigraph, chosen fail first, and its admissible estimate comes from the reduced costs of the
+// parent's assignment bound, so a child is ranked without being expanded.
+// 1. nodes live in an arena (fixed size blocks, a node is its parent + the pair it maps), the open ones in a priority queue
+//    ordered by the estimate; expanding a node moves the incremental state of the branch and bound along the tree path
+// 2. every expanded node also turns its assignment into a complete mapping, which keeps improving the upper bound
+// 3. once the arena and the queue reach the memory cap, the open nodes are finished one by one, best estimate first,
+//    by the depth-first branch and bound, which needs no more memory
+// When the time limit stops either phase, the best mapping so far is returned with the smallest open estimate as a lower bound.
+// It reaches about as far as the branch and bound: random pairs of 16 vertices take seconds, 18 vertices and more are
+// not exact after a minute, and most of them reach the default 256 MB cap and finish depth first.
+
+struct GraphEditDistanceAStarNode {
+    int parent;
+    // Vertex of the 2nd multigraph mapped by this node onto the vertex of the 1st one, -1 for the root
+    int vertex2;
+    int vertex1;
+    int depth;
+    int cost;
+};
+
+struct GraphEditDistanceAStarQueueEntry {
+    int bound;
+    int depth;
+    int node;
+};
+
+// Smallest bound first, deeper first among equal bounds, so complete mappings are reached early
+bool operator<(const GraphEditDistanceAStarQueueEntry& a, const GraphEditDistanceAStarQueueEntry& b) {
+    if (a.bound != b.bound) {
+        return a.bound > b.bound;
+    }
+    if (a.depth != b.depth) {
+        return a.depth < b.depth;
+    }
+    return a.node > b.node;
+}
+
+// Nodes are never freed one by one, so they are allocated in blocks that never move
+struct GraphEditDistanceAStarArena {
+    static const int blockSize = 1 << 16;
+
+    std::vector<std::vector<GraphEditDistanceAStarNode>> blocks;
+    std::size_t size = 0;
+
+    GraphEditDistanceAStarNode& operator[](std::size_t index) {
+        return blocks[index / blockSize][index % blockSize];
+    }
+
+    int push(const GraphEditDistanceAStarNode& node) {
+        if (size % blockSize == 0) {
+            blocks.emplace_back();
+            blocks.back().reserve(blockSize);
+        }
+        blocks.back().push_back(node);
+        return size++;
+    }
+};
+
+struct GraphEditDistanceAStarResult {
+    // Upper bound, the graph edit distance when isExact
+    int graphEditDistance;
+    int lowerBound;
+    bool isExact;
+    bool hasReachedMemoryLimit;
+    long long numExpandedNodes;
+    std::vector<int> permutation;
+};
+
+// Moves the branch and bound state from the nodes of currentPath to the ones of newPath (both root excluded):
+// undoes the current nodes below their common ancestor and maps the new ones
+void graphEditDistanceAStarMoveTo(GraphEditDistanceBranchAndBoundSearch& search, GraphEditDistanceAStarArena& arena, std::vector<int>& currentPath, const std::vector<int>& newPath) {
+    // Time complexity: O(depth * (V^2 + V * L))
+
+    int commonDepth = 0;
+    while (commonDepth < (int)currentPath.size() && commonDepth < (int)newPath.size() && currentPath[commonDepth] == newPath[commonDepth]) {
+        commonDepth++;
+    }
+
+    for (int depth = (int)currentPath.size() - 1; depth >= commonDepth; depth--) {
+        const GraphEditDistanceAStarNode& node = arena[currentPath[depth]];
+        graphEditDistanceBranchAndBoundUpdate(search, depth, node.vertex2, node.vertex1, -1);
+        search.isUsed[node.vertex1] = 0;
+        search.permutation[node.vertex2] = -1;
+    }
+
+    for (int depth = commonDepth; depth < (int)newPath.size(); depth++) {
+        const GraphEditDistanceAStarNode& node = arena[newPath[depth]];
+        int position = std::find(search.order.begin() + depth, search.order.end(), node.vertex2) - search.order.begin();
+        std::swap(search.order[depth], search.order[position]);
+
+        search.permutation[node.vertex2] = node.vertex1;
+        search.isUsed[node.vertex1] = 1;
+        graphEditDistanceBranchAndBoundUpdate(search, depth, node.vertex2, node.vertex1, 1);
+    }
+
+    currentPath = newPath;
+}
+
+// memoryLimitBytes bounds the arena and the queue, timeLimitMilliseconds <= 0 means no time limit
+template <typename Multigraph>
+GraphEditDistanceAStarResult graphEditDistanceAStar(const Multigraph& multigraph1, const Multigraph& multigraph2, long long memoryLimitBytes, long long timeLimitMilliseconds) {
+    // Time complexity: O(V^3 * V!) in the worst case, O(V^3) per expanded node
+    // Space complexity: O(memoryLimitBytes + V^2 * L)
+
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    int numVertices = multigraphs.numVertices;
+
+    if (numVertices == 0) {
+        return {0, 0, true, false, 0, {}};
+    }
+
+    GraphEditDistanceBranchAndBoundSearch search = makeGraphEditDistanceBranchAndBoundSearch(multigraphs);
+    initGraphEditDistanceBranchAndBoundSearch(search, degreeSequenceMapping(multigraphs));
+    if (timeLimitMilliseconds > 0) {
+        search.hasDeadline = true;
+        search.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMilliseconds);
+    }
+
+    // The queue may hold up to twice its entries while it grows
+    long long maxNumNodes = memoryLimitBytes / (long long)(sizeof(GraphEditDistanceAStarNode) + 2 * sizeof(GraphEditDistanceAStarQueueEntry));
+
+    GraphEditDistanceAStarArena arena;
+    std::priority_queue<GraphEditDistanceAStarQueueEntry> queue;
+    arena.push({-1, -1, -1, 0, 0});
+    queue.push({0, 0, 0});
+
+    std::vector<int> currentPath;
+    std::vector<int> newPath;
+    std::vector<int> mapping(numVertices);
+
+    int lowerBound = 0;
+    bool isExact = false;
+    bool hasReachedMemoryLimit = false;
+    long long numExpandedNodes = 0;
+
+    auto isTimedOut = [&search]() {
+        return search.isTimedOut || (search.hasDeadline && std::chrono::steady_clock::now() >= search.deadline);
+    };
+
+    auto pathTo = [&arena, &newPath](int nodeIndex) {
+        newPath.clear();
+        for (int index = nodeIndex; arena[index].parent != -1; index = arena[index].parent) {
+            newPath.push_back(index);
+        }
+        std::reverse(newPath.begin(), newPath.end());
+    };
+
+    while (true) {
+        if (queue.empty() || queue.top().bound >= search.bestCost) {
+            isExact = true;
+            break;
+        }
+        if (isTimedOut()) {
+            lowerBound = queue.top().bound;
+            break;
+        }
+        if ((long long)arena.size + numVertices > maxNumNodes) {
+            hasReachedMemoryLimit = true;
+            break;
+        }
+
+        GraphEditDistanceAStarQueueEntry entry = queue.top();
+        queue.pop();
+        numExpandedNodes++;
+
+        int nodeIndex = entry.node;
+        int depth = entry.depth;
+        int partialCost = arena[nodeIndex].cost;
+
+        pathTo(nodeIndex);
+        graphEditDistanceAStarMoveTo(search, arena, currentPath, newPath);
+
+        long long doubledLowerBound = graphEditDistanceBranchAndBoundAssignmentBound(search, depth);
+        if (partialCost + (doubledLowerBound + 1) / 2 >= search.bestCost) {
+            continue;
+        }
+
+        // The assignment completes the partial mapping, a free upper bound
+        for (int k = 0; k < depth; k++) {
+            mapping[search.order[k]] = search.permutation[search.order[k]];
+        }
+        for (int row = 0; row < numVertices - depth; row++) {
+            mapping[search.order[depth + row]] = search.unusedVertices[search.linearAssignment.rowAssignment[row]];
+        }
+        int mappingCost = graphEditDistanceMappingCost(multigraphs, mapping);
+        if (mappingCost < search.bestCost) {
+            search.bestCost = mappingCost;
+            search.bestPermutation = mapping;
+        }
+
+        int numCandidates = numVertices - depth;
+        int row = graphEditDistanceBranchAndBoundSelectRow(search, depth, partialCost, doubledLowerBound);
+        std::swap(search.order[depth], search.order[depth + row]);
+        int i = search.order[depth];
+
+        for (int column = 0; column < numCandidates; column++) {
+            long long reducedCost = linearAssignmentReducedCost(search.linearAssignment, search.assignmentCost.data(), numCandidates, row, column);
+            int childBound = std::max<long long>(entry.bound, partialCost + (doubledLowerBound + reducedCost + 1) / 2);
+            if (childBound >= search.bestCost) {
+                continue;
+            }
+
+            int u = search.unusedVertices[column];
+            int childCost = partialCost + search.crossCost[(size_t)i * numVertices + u];
+
+            if (depth + 1 == numVertices) {
+                if (childCost < search.bestCost) {
+                    search.bestCost = childCost;
+                    search.bestPermutation = search.permutation;
+                    search.bestPermutation[i] = u;
+                }
+                continue;
+            }
+
+            int childIndex = arena.push({nodeIndex, i, u, depth + 1, childCost});
+            queue.push({childBound, depth + 1, childIndex});
+        }
+    }
+
+    // Out of memory: finish the open nodes depth first, best estimate first
+    if (hasReachedMemoryLimit) {
+        isExact = true;
+        while (!queue.empty() && queue.top().bound < search.bestCost) {
+            GraphEditDistanceAStarQueueEntry entry = queue.top();
+            queue.pop();
+
+            pathTo(entry.node);
+            graphEditDistanceAStarMoveTo(search, arena, currentPath, newPath);
+            graphEditDistanceBranchAndBoundHelper(search, entry.depth, arena[entry.node].cost);
+
+            if (search.isTimedOut) {
+                isExact = false;
+                lowerBound = entry.bound;
+                break;
+            }
+        }
+    }
+
+    if (isExact) {
+        lowerBound = search.bestCost;
+    }
+
+    return {
+        multigraphs.vertexCountDifference + search.bestCost,
+        multigraphs.vertexCountDifference + std::min(lowerBound, search.bestCost),
+        isExact,
+        hasReachedMemoryLimit,
+        numExpandedNodes,
+        search.bestPermutation
+    };
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_A_STAR_H
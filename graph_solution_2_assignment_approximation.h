@@ -0,0 +1,237 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "graph_edit_distance_utils.h"
+#include "linear_assignment.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_ASSIGNMENT_APPROXIMATION_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_ASSIGNMENT_APPROXIMATION_H
+
+// Graph edit distance approximation by bipartite assignment (Riesen-Bunke style), with a certified interval.
+// Every vertex pair (i of the 2nd multigraph, u of the 1st one) gets the cost
+//   rowsDistance(i, u) = min over bijections of the two rows (self-loops excluded) of the sum of |differences|
+// i.e. the distance between the sorted rows, the local edge-multiplicity structure around the two vertices.
+// The cheapest assignment of the rows is found by the Hungarian algorithm (linear_assignment.h), and:
+// 1. for any mapping p, the edges cost counts every pair twice and sum over i of |row1(p(i)) - row2(i)| is at least
+//    sum over i of rowsDistance(i, p(i)), so half of the assignment optimum (rounded up) is a lower bound
+// 2. the optimal assignment is itself a mapping, its exact cost is an upper bound
+// 3. the upper bound is tightened by re-assigning with the costs linearised around the current mapping,
+//    which lets the vertices identified by the rows pull their neighbours into place
+// Both come with |V1 - V2| added, like graphEditDistance.
+
+struct GraphEditDistanceApproximation {
+    int lowerBound;
+    int upperBound;
+    // permutation[i] is the vertex of the 1st multigraph mapped onto the vertex i of the 2nd one,
+    // vertices numbered from the smaller multigraph's size up are the padding (inserted / deleted vertices)
+    std::vector<int> permutation;
+};
+
+// rowsDistance of all vertex pairs, cost[i * V + u] for the vertex i of the 2nd multigraph and u of the 1st one.
+// With L distinct multiplicities, for sorted non negative rows a and b
+//   sum over k of |a_k - b_k| = sum over levels t of (gap to the previous level) * |#{a >= t} - #{b >= t}|
+// so the rows are reduced to their counts above every level (as in graph_solution_2_branch_and_bound.h);
+// when there are more levels than vertices the sorted rows are compared directly instead.
+std::vector<long long> graphEditDistanceRowsDistanceMatrix(const PaddedMultigraphPair& multigraphs) {
+    // Time complexity: O(V^2 * min(L, V))
+    // Space complexity: O(V^2)
+
+    int numVertices = multigraphs.numVertices;
+    const DenseMultigraph<int>& multigraph1 = multigraphs.multigraph1;
+    const DenseMultigraph<int>& multigraph2 = multigraphs.multigraph2;
+
+    std::vector<int> levels;
+    for (int u = 0; u < numVertices; u++) {
+        for (int w = 0; w < numVertices; w++) {
+            if (u == w) {
+                continue;
+            }
+            if (multigraph1[u][w] > 0) {
+                levels.push_back(multigraph1[u][w]);
+            }
+            if (multigraph2[u][w] > 0) {
+                levels.push_back(multigraph2[u][w]);
+            }
+        }
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    int numLevels = levels.size();
+
+    std::vector<long long> cost((size_t)numVertices * numVertices, 0);
+
+    if (numLevels <= numVertices) {
+        // levelCounts[u * L + l] = number of w != u with multigraph[u][w] >= levels[l]
+        auto makeLevelCounts = [&levels, numVertices, numLevels](const DenseMultigraph<int>& multigraph) {
+            std::vector<int> levelCounts((size_t)numVertices * numLevels, 0);
+            for (int u = 0; u < numVertices; u++) {
+                int* countsRow = &levelCounts[(size_t)u * numLevels];
+                for (int w = 0; w < numVertices; w++) {
+                    if (u != w && multigraph[u][w] > 0) {
+                        countsRow[std::lower_bound(levels.begin(), levels.end(), multigraph[u][w]) - levels.begin()]++;
+                    }
+                }
+                for (int level = numLevels - 2; level >= 0; level--) {
+                    countsRow[level] += countsRow[level + 1];
+                }
+            }
+            return levelCounts;
+        };
+
+        std::vector<int> levelCounts1 = makeLevelCounts(multigraph1);
+        std::vector<int> levelCounts2 = makeLevelCounts(multigraph2);
+        std::vector<int> levelWeights(numLevels);
+        for (int level = 0; level < numLevels; level++) {
+            levelWeights[level] = levels[level] - (level > 0 ? levels[level - 1] : 0);
+        }
+
+        for (int i = 0; i < numVertices; i++) {
+            const int* countsRow2 = &levelCounts2[(size_t)i * numLevels];
+            long long* costRow = &cost[(size_t)i * numVertices];
+            for (int u = 0; u < numVertices; u++) {
+                const int* countsRow1 = &levelCounts1[(size_t)u * numLevels];
+                long long rowsDistance = 0;
+                for (int level = 0; level < numLevels; level++) {
+                    rowsDistance += (long long)levelWeights[level] * std::abs(countsRow1[level] - countsRow2[level]);
+                }
+                costRow[u] = rowsDistance;
+            }
+        }
+    } else {
+        // Rows without the self-loop, sorted in decreasing order
+        auto makeSortedRows = [numVertices](const DenseMultigraph<int>& multigraph) {
+            std::vector<int> sortedRows((size_t)numVertices * (numVertices - 1));
+            for (int u = 0; u < numVertices; u++) {
+                int* sortedRow = &sortedRows[(size_t)u * (numVertices - 1)];
+                int k = 0;
+                for (int w = 0; w < numVertices; w++) {
+                    if (u != w) {
+                        sortedRow[k++] = multigraph[u][w];
+                    }
+                }
+                std::sort(sortedRow, sortedRow + numVertices - 1, std::greater<int>());
+            }
+            return sortedRows;
+        };
+
+        std::vector<int> sortedRows1 = makeSortedRows(multigraph1);
+        std::vector<int> sortedRows2 = makeSortedRows(multigraph2);
+
+        for (int i = 0; i < numVertices; i++) {
+            const int* sortedRow2 = &sortedRows2[(size_t)i * (numVertices - 1)];
+            long long* costRow = &cost[(size_t)i * numVertices];
+            for (int u = 0; u < numVertices; u++) {
+                const int* sortedRow1 = &sortedRows1[(size_t)u * (numVertices - 1)];
+                long long rowsDistance = 0;
+                for (int k = 0; k < numVertices - 1; k++) {
+                    rowsDistance += std::abs(sortedRow1[k] - sortedRow2[k]);
+                }
+                costRow[u] = rowsDistance;
+            }
+        }
+    }
+
+    return cost;
+}
+
+// Cost of mapping the vertex i onto u when every other vertex j stays mapped onto permutation[j]:
+//   cost[i * V + u] = sum over j != i of |multigraph1[u][permutation[j]] - multigraph2[i][j]|
+// (with the one pair j = permutation^-1(u) approximated). It is the exact change of the edges cost along a single vertex,
+// so its optimal assignment is a mapping at least as good as the current one in most cases.
+// |a - b| = a + b - 2 min(a, b) and min is 0 unless both are edges, so only pairs of edges are visited.
+std::vector<long long> graphEditDistanceLinearisedCostMatrix(const PaddedMultigraphPair& multigraphs, const std::vector<int>& permutation) {
+    // Time complexity: O(V^2 + sum over j of deg2(j) * deg1(permutation[j]))
+    // Space complexity: O(V^2)
+
+    int numVertices = multigraphs.numVertices;
+    const DenseMultigraph<int>& multigraph1 = multigraphs.multigraph1;
+    const DenseMultigraph<int>& multigraph2 = multigraphs.multigraph2;
+
+    std::vector<std::vector<int>> neighbours1(numVertices);
+    std::vector<std::vector<int>> neighbours2(numVertices);
+    for (int u = 0; u < numVertices; u++) {
+        for (int w = 0; w < numVertices; w++) {
+            if (u == w) {
+                continue;
+            }
+            if (multigraph1[u][w] > 0) {
+                neighbours1[u].push_back(w);
+            }
+            if (multigraph2[u][w] > 0) {
+                neighbours2[u].push_back(w);
+            }
+        }
+    }
+
+    std::vector<int> degrees1 = offDiagonalDegrees(multigraph1);
+    std::vector<int> degrees2 = offDiagonalDegrees(multigraph2);
+
+    std::vector<long long> cost((size_t)numVertices * numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        long long* costRow = &cost[(size_t)i * numVertices];
+        for (int u = 0; u < numVertices; u++) {
+            costRow[u] = degrees1[u] + degrees2[i];
+        }
+
+        for (int j : neighbours2[i]) {
+            int w = permutation[j];
+            for (int u : neighbours1[w]) {
+                costRow[u] -= 2LL * std::min(multigraph1[u][w], multigraph2[i][j]);
+            }
+        }
+    }
+
+    return cost;
+}
+
+template <typename Multigraph>
+GraphEditDistanceApproximation graphEditDistanceAssignmentApproximation(const Multigraph& multigraph1, const Multigraph& multigraph2, int maxRefinementRounds = 3) {
+    // Time complexity: O(V^2 * min(L, V) + V^3) per round
+    // Space complexity: O(V^2)
+
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    int numVertices = multigraphs.numVertices;
+
+    if (numVertices == 0) {
+        return {0, 0, {}};
+    }
+
+    std::vector<long long> cost = graphEditDistanceRowsDistanceMatrix(multigraphs);
+
+    LinearAssignment linearAssignment;
+    long long assignmentCost = solveLinearAssignment(linearAssignment, cost.data(), numVertices, numVertices);
+
+    std::vector<int> permutation = linearAssignment.rowAssignment;
+    int mappingCost = graphEditDistanceMappingCost(multigraphs, permutation);
+
+    // Tighten the upper bound: re-assign against the edges of the current mapping while it improves
+    for (int round = 0; round < maxRefinementRounds; round++) {
+        std::vector<long long> linearisedCost = graphEditDistanceLinearisedCostMatrix(multigraphs, permutation);
+        solveLinearAssignment(linearAssignment, linearisedCost.data(), numVertices, numVertices);
+
+        int refinedCost = graphEditDistanceMappingCost(multigraphs, linearAssignment.rowAssignment);
+        if (refinedCost >= mappingCost) {
+            break;
+        }
+
+        mappingCost = refinedCost;
+        permutation = linearAssignment.rowAssignment;
+    }
+
+    // The rows bound assumes symmetric matrices, on a non symmetric input file it is kept within the upper bound
+    int lowerBound = std::min((int)((assignmentCost + 1) / 2), mappingCost);
+
+    return {
+        multigraphs.vertexCountDifference + lowerBound,
+        multigraphs.vertexCountDifference + mappingCost,
+        permutation
+    };
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_ASSIGNMENT_APPROXIMATION_H
@@ -0,0 +1,241 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "graph_edit_distance_utils.h"
+#include "graph_solution_2_assignment_approximation.h"
+#include "simd_kernels.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_BEAM_SEARCH_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_BEAM_SEARCH_H
+
+// Graph edit distance by beam search: the middle ground between graphEditDistance and the degree sequence approximation.
+// Vertices of the 2nd multigraph are mapped level by level (highest degree first) like in the branch and bound,
+// but only the beamWidth best partial mappings of every level are extended, ranked by cost + heuristic:
+// 1. cost: exact edges cost of the pairs between already mapped vertices
+// 2. heuristic: the not mapped part has to pay at least the difference of the edge totals,
+//    |internal2 - internal1| for the pairs inside the not mapped vertices and |cross2 - cross1| for the pairs between
+//    the not mapped and the mapped vertices (sum of |a - b| >= |sum a - sum b|)
+// 3. or, when larger, half of the rows distances (graph_solution_2_assignment_approximation.h) of the mapped pairs
+//    plus the smallest possible ones of the not mapped vertices, which sees the whole neighbourhood of a vertex
+//    already at the first levels, where the mapped part is still too small to tell the candidates apart
+// Every level costs O(beamWidth * V^2), so the running time grows linearly with the beam width,
+// and beamWidth = V! would be exhaustive. The best complete mapping is polished by swaps at the end.
+
+struct GraphEditDistanceBeamCandidate {
+    long long score;
+    int cost;
+    int parent;
+    int vertex;
+};
+
+bool operator<(const GraphEditDistanceBeamCandidate& a, const GraphEditDistanceBeamCandidate& b) {
+    if (a.score != b.score) {
+        return a.score < b.score;
+    }
+    if (a.cost != b.cost) {
+        return a.cost < b.cost;
+    }
+    if (a.parent != b.parent) {
+        return a.parent < b.parent;
+    }
+    return a.vertex < b.vertex;
+}
+
+// A level of the beam, every partial mapping keeps numVertices entries of each array
+struct GraphEditDistanceBeam {
+    int numStates;
+    // permutations[s * V + d] is the vertex of the 1st multigraph mapped onto the d-th vertex of the order
+    std::vector<int> permutations;
+    std::vector<char> isUsed;
+    // rowSumsToUnused[s * V + w] = sum over unused w' != w of multigraph1[w][w']
+    std::vector<long long> rowSumsToUnused;
+    std::vector<int> costs;
+    // Edge totals inside the unused / between the used vertices of the 1st multigraph
+    std::vector<long long> unusedInternals;
+    std::vector<long long> mappedInternals;
+    // Sum of rowsDistance(d, p(d)) over the mapped vertices
+    std::vector<long long> rowsDistanceSums;
+};
+
+void resizeGraphEditDistanceBeam(GraphEditDistanceBeam& beam, int numStates, int numVertices) {
+    beam.numStates = numStates;
+    beam.permutations.resize((size_t)numStates * numVertices);
+    beam.isUsed.resize((size_t)numStates * numVertices);
+    beam.rowSumsToUnused.resize((size_t)numStates * numVertices);
+    beam.costs.resize(numStates);
+    beam.unusedInternals.resize(numStates);
+    beam.mappedInternals.resize(numStates);
+    beam.rowsDistanceSums.resize(numStates);
+}
+
+// Minimal edges edit distance found by the beam (without the vertex count difference), permutation receives its mapping
+int graphEditDistanceBeamSearchEdgesCost(const PaddedMultigraphPair& multigraphs, int beamWidth, std::vector<int>& permutation) {
+    // Time complexity: O(beamWidth * V^3) + O(V^3) per round of swaps
+    // Space complexity: O(beamWidth * V + V^2)
+
+    // At least one partial mapping is kept, whatever the caller asks for
+    beamWidth = std::max(1, beamWidth);
+    int numVertices = multigraphs.numVertices;
+    const DenseMultigraph<int>& multigraph1 = multigraphs.multigraph1;
+
+    if (numVertices == 0) {
+        permutation.clear();
+        return 0;
+    }
+
+    // The 2nd multigraph renumbered in the order of mapping, so that the mapped vertices are always 0..d - 1
+    std::vector<int> degrees1 = offDiagonalDegrees(multigraph1);
+    std::vector<int> degrees2 = offDiagonalDegrees(multigraphs.multigraph2);
+    std::vector<int> order(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&degrees2](int a, int b) {
+        return degrees2[a] > degrees2[b];
+    });
+
+    DenseMultigraph<int> multigraph2(numVertices);
+    for (int a = 0; a < numVertices; a++) {
+        for (int b = 0; b < numVertices; b++) {
+            multigraph2[a][b] = a == b ? 0 : multigraphs.multigraph2[order[a]][order[b]];
+        }
+    }
+
+    // Edge totals of the 2nd multigraph depend on the level only:
+    // internal2[d] inside the vertices d..V - 1, cross2[d] between them and 0..d - 1
+    std::vector<long long> internal2(numVertices + 1, 0);
+    std::vector<long long> cross2(numVertices + 1, 0);
+    long long total2 = 0;
+    for (int a = 0; a < numVertices; a++) {
+        for (int b = a + 1; b < numVertices; b++) {
+            total2 += multigraph2[a][b];
+        }
+    }
+    long long mapped2 = 0;
+    internal2[0] = total2;
+    for (int d = 1; d <= numVertices; d++) {
+        for (int b = 0; b < d - 1; b++) {
+            mapped2 += multigraph2[d - 1][b];
+        }
+        long long rowToRest = degrees2[order[d - 1]];
+        for (int b = 0; b < d - 1; b++) {
+            rowToRest -= multigraph2[d - 1][b];
+        }
+        internal2[d] = internal2[d - 1] - rowToRest;
+        cross2[d] = total2 - internal2[d] - mapped2;
+    }
+
+    // rowsDistance of every vertex pair (graph_solution_2_assignment_approximation.h), rows in the order of mapping.
+    // Twice the edges cost is at least the sum of rowsDistance(d, p(d)) over all vertices, which ranks the mapped
+    // vertices by their whole neighbourhood instead of the mapped part only
+    std::vector<long long> rowsDistances = graphEditDistanceRowsDistanceMatrix(multigraphs);
+    std::vector<long long> minimalRowsDistanceSuffix(numVertices + 1, 0);
+    for (int a = numVertices - 1; a >= 0; a--) {
+        const long long* rowsDistanceRow = &rowsDistances[(size_t)order[a] * numVertices];
+        minimalRowsDistanceSuffix[a] = minimalRowsDistanceSuffix[a + 1] + *std::min_element(rowsDistanceRow, rowsDistanceRow + numVertices);
+    }
+
+    long long total1 = 0;
+    for (int u = 0; u < numVertices; u++) {
+        total1 += degrees1[u];
+    }
+    total1 /= 2;
+
+    GraphEditDistanceBeam beam;
+    GraphEditDistanceBeam nextBeam;
+    resizeGraphEditDistanceBeam(beam, 1, numVertices);
+    for (int u = 0; u < numVertices; u++) {
+        beam.isUsed[u] = 0;
+        beam.rowSumsToUnused[u] = degrees1[u];
+    }
+    beam.costs[0] = 0;
+    beam.unusedInternals[0] = total1;
+    beam.mappedInternals[0] = 0;
+    beam.rowsDistanceSums[0] = 0;
+
+    std::vector<GraphEditDistanceBeamCandidate> candidates;
+
+    for (int d = 0; d < numVertices; d++) {
+        const int* row2 = multigraph2[d];
+        const long long* rowsDistanceRow = &rowsDistances[(size_t)order[d] * numVertices];
+
+        candidates.clear();
+        for (int s = 0; s < beam.numStates; s++) {
+            const int* statePermutation = &beam.permutations[(size_t)s * numVertices];
+            const char* stateIsUsed = &beam.isUsed[(size_t)s * numVertices];
+            const long long* stateRowSums = &beam.rowSumsToUnused[(size_t)s * numVertices];
+
+            for (int u = 0; u < numVertices; u++) {
+                if (stateIsUsed[u]) {
+                    continue;
+                }
+
+                int cost = beam.costs[s] + permutedAbsoluteDifferenceSum(multigraph1[u], statePermutation, row2, 0, d);
+                long long unusedInternal = beam.unusedInternals[s] - stateRowSums[u];
+                long long mappedInternal = beam.mappedInternals[s] + (degrees1[u] - stateRowSums[u]);
+                long long cross1 = total1 - unusedInternal - mappedInternal;
+
+                long long heuristic = std::abs(internal2[d + 1] - unusedInternal) + std::abs(cross2[d + 1] - cross1);
+                long long rowsEstimate = (beam.rowsDistanceSums[s] + rowsDistanceRow[u] + minimalRowsDistanceSuffix[d + 1] + 1) / 2;
+                candidates.push_back({std::max(cost + heuristic, rowsEstimate), cost, s, u});
+            }
+        }
+
+        int numKept = std::min((int)candidates.size(), beamWidth);
+        std::nth_element(candidates.begin(), candidates.begin() + (numKept - 1), candidates.end());
+        std::sort(candidates.begin(), candidates.begin() + numKept);
+
+        resizeGraphEditDistanceBeam(nextBeam, numKept, numVertices);
+        for (int t = 0; t < numKept; t++) {
+            const GraphEditDistanceBeamCandidate& candidate = candidates[t];
+            int s = candidate.parent;
+            int u = candidate.vertex;
+
+            std::copy_n(&beam.permutations[(size_t)s * numVertices], d, &nextBeam.permutations[(size_t)t * numVertices]);
+            std::copy_n(&beam.isUsed[(size_t)s * numVertices], numVertices, &nextBeam.isUsed[(size_t)t * numVertices]);
+            nextBeam.permutations[(size_t)t * numVertices + d] = u;
+            nextBeam.isUsed[(size_t)t * numVertices + u] = 1;
+
+            const long long* stateRowSums = &beam.rowSumsToUnused[(size_t)s * numVertices];
+            long long* nextStateRowSums = &nextBeam.rowSumsToUnused[(size_t)t * numVertices];
+            for (int w = 0; w < numVertices; w++) {
+                nextStateRowSums[w] = stateRowSums[w] - (w == u ? 0 : multigraph1[w][u]);
+            }
+
+            nextBeam.costs[t] = candidate.cost;
+            nextBeam.unusedInternals[t] = beam.unusedInternals[s] - stateRowSums[u];
+            nextBeam.mappedInternals[t] = beam.mappedInternals[s] + (degrees1[u] - stateRowSums[u]);
+            nextBeam.rowsDistanceSums[t] = beam.rowsDistanceSums[s] + rowsDistanceRow[u];
+        }
+
+        std::swap(beam, nextBeam);
+    }
+
+    // The last level is sorted, the first state is the best one
+    permutation.assign(numVertices, 0);
+    for (int a = 0; a < numVertices; a++) {
+        permutation[order[a]] = beam.permutations[a];
+    }
+
+    int cost = graphEditDistanceMappingCost(multigraphs, permutation);
+    return improveMappingBySwaps(multigraphs, permutation, cost);
+}
+
+template <typename Multigraph>
+int graphEditDistanceBeamSearch(const Multigraph& multigraph1, const Multigraph& multigraph2, int beamWidth) {
+    // Time complexity: O(beamWidth * V^3)
+    // Space complexity: O(beamWidth * V + V^2)
+
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    std::vector<int> permutation;
+
+    return multigraphs.vertexCountDifference + graphEditDistanceBeamSearchEdgesCost(multigraphs, beamWidth, permutation);
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_BEAM_SEARCH_H
@@ -0,0 +1,444 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cstdlib>
+#include <chrono>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "graph_edit_distance_utils.h"
+#include "linear_assignment.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_BRANCH_AND_BOUND_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_BRANCH_AND_BOUND_H
+
+// Exact graph edit distance by branch and bound.
+// Vertices of the 2nd multigraph are mapped one by one onto the unused vertices of the 1st one,
+// keeping the cost of the pairs between already mapped vertices.
+//
+// The rest of the cost is estimated by an admissible lower bound. If the not mapped vertex i goes to the unused vertex u:
+// 1. pairs (i, mapped j) cost exactly crossCost[i][u]
+// 2. pairs (i, not mapped j) cost at least the distance between the sorted rows of i and u restricted to the not mapped vertices,
+//    counted from both ends, i.e. half of it per vertex. This is the degree sequence idea of graphEditDistancePolynomialApproximation,
+//    but per vertex and for the whole row instead of its sum.
+// The cheapest way to pay (2 * crossCost + rowsDistance) for every not mapped vertex is a linear assignment problem,
+// and half of its optimum never overestimates. Its reduced costs also bound every child without expanding it.
+//
+// The rows distance is computed on multiplicity levels: for sorted non negative rows a and b,
+//   sum over k of |a_k - b_k| = sum over t >= 1 of |#{a >= t} - #{b >= t}|
+// so every vertex keeps the counts of its remaining neighbours above every distinct multiplicity level.
+//
+// The search is exponential: random pairs of 16 vertices take seconds, 18 vertices and more do not finish in a minute,
+// while near isomorphic pairs of 25 vertices are solved at the root. graphEditDistanceBranchAndBoundWithTimeLimit stops
+// it with the best mapping so far.
+
+struct GraphEditDistanceBranchAndBoundSearch {
+    const PaddedMultigraphPair& multigraphs;
+    int numVertices;
+
+    // Order in which vertices of the 2nd multigraph are mapped
+    std::vector<int> order;
+    // permutation[i] is the vertex of the 1st multigraph mapped onto i, -1 if not mapped yet
+    std::vector<int> permutation;
+    std::vector<char> isUsed;
+
+    // crossCost[i * V + u] = sum over mapped j of |multigraph1[u][permutation[j]] - multigraph2[i][j]|
+    std::vector<int> crossCost;
+
+    // Distinct multiplicity levels of both multigraphs and the gap to the previous level
+    int numLevels;
+    std::vector<int> levelWeights;
+    // levelIndex[u][w] = number of levels <= multigraph[u][w]
+    DenseMultigraph<int> levelIndex1;
+    DenseMultigraph<int> levelIndex2;
+    // levelCounts[u * L + l] = number of not mapped / unused neighbours w of u with multigraph[u][w] >= level l
+    std::vector<int> levelCounts1;
+    std::vector<int> levelCounts2;
+
+    // Preallocated buffers, so the search does not allocate
+    std::vector<long long> assignmentCost;
+    LinearAssignment linearAssignment;
+    std::vector<int> unusedVertices;
+    std::vector<int> candidates;
+    std::vector<long long> candidateBounds;
+
+    int bestCost;
+    std::vector<int> bestPermutation;
+
+    // Optional time limit, checked every few hundred nodes; the search stops with the best mapping so far
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+    bool isTimedOut;
+    long long numNodes;
+};
+
+// Every member set, the buffers are sized by initGraphEditDistanceBranchAndBoundSearch
+GraphEditDistanceBranchAndBoundSearch makeGraphEditDistanceBranchAndBoundSearch(const PaddedMultigraphPair& multigraphs) {
+    return {
+        multigraphs,
+        multigraphs.numVertices,
+        {},
+        {},
+        {},
+        {},
+        0,
+        {},
+        {},
+        {},
+        {},
+        {},
+        {},
+        {},
+        {},
+        {},
+        {},
+        0,
+        {},
+        false,
+        {},
+        false,
+        0
+    };
+}
+
+// Builds the assignment cost matrix of the not mapped vertices (rows: order[depth..], columns: unusedVertices)
+// and returns the optimum of the assignment, in doubled cost units.
+long long graphEditDistanceBranchAndBoundAssignmentBound(GraphEditDistanceBranchAndBoundSearch& search, int depth) {
+    // Time complexity: O(V^2 * L + V^3)
+
+    int numVertices = search.numVertices;
+    int numRemaining = numVertices - depth;
+    int numLevels = search.numLevels;
+
+    int numUnused = 0;
+    for (int u = 0; u < numVertices; u++) {
+        if (!search.isUsed[u]) {
+            search.unusedVertices[numUnused++] = u;
+        }
+    }
+
+    for (int row = 0; row < numRemaining; row++) {
+        int i = search.order[depth + row];
+        const int* crossCostRow = &search.crossCost[(size_t)i * numVertices];
+        const int* levelCountsRow2 = search.levelCounts2.data() + (size_t)i * numLevels;
+        long long* assignmentCostRow = &search.assignmentCost[(size_t)row * numRemaining];
+
+        for (int column = 0; column < numRemaining; column++) {
+            int u = search.unusedVertices[column];
+            const int* levelCountsRow1 = search.levelCounts1.data() + (size_t)u * numLevels;
+
+            long long rowsDistance = 0;
+            for (int level = 0; level < numLevels; level++) {
+                rowsDistance += (long long)search.levelWeights[level] * std::abs(levelCountsRow1[level] - levelCountsRow2[level]);
+            }
+
+            assignmentCostRow[column] = 2LL * crossCostRow[u] + rowsDistance;
+        }
+    }
+
+    return solveLinearAssignment(search.linearAssignment, search.assignmentCost.data(), numRemaining, numRemaining);
+}
+
+// Map i onto u (sign = 1) or undo it (sign = -1). u must already be marked as used.
+void graphEditDistanceBranchAndBoundUpdate(GraphEditDistanceBranchAndBoundSearch& search, int depth, int i, int u, int sign) {
+    // Time complexity: O(V^2 + V * L)
+
+    int numVertices = search.numVertices;
+    int numLevels = search.numLevels;
+    const DenseMultigraph<int>& multigraph1 = search.multigraphs.multigraph1;
+    const DenseMultigraph<int>& multigraph2 = search.multigraphs.multigraph2;
+
+    for (int k = depth + 1; k < numVertices; k++) {
+        int otherI = search.order[k];
+        int secondGraphMultiplicity = multigraph2[otherI][i];
+        int* crossCostRow = &search.crossCost[(size_t)otherI * numVertices];
+
+        for (int otherU = 0; otherU < numVertices; otherU++) {
+            if (!search.isUsed[otherU]) {
+                crossCostRow[otherU] += sign * std::abs(multigraph1[otherU][u] - secondGraphMultiplicity);
+            }
+        }
+
+        int* levelCountsRow2 = search.levelCounts2.data() + (size_t)otherI * numLevels;
+        for (int level = 0; level < search.levelIndex2[otherI][i]; level++) {
+            levelCountsRow2[level] -= sign;
+        }
+    }
+
+    for (int otherU = 0; otherU < numVertices; otherU++) {
+        if (search.isUsed[otherU]) {
+            continue;
+        }
+
+        int* levelCountsRow1 = search.levelCounts1.data() + (size_t)otherU * numLevels;
+        for (int level = 0; level < search.levelIndex1[otherU][u]; level++) {
+            levelCountsRow1[level] -= sign;
+        }
+    }
+}
+
+// After graphEditDistanceBranchAndBoundAssignmentBound: the row (position in order[depth..]) with the fewest
+// children whose reduced cost bound stays below the best cost
+int graphEditDistanceBranchAndBoundSelectRow(const GraphEditDistanceBranchAndBoundSearch& search, int depth, int partialCost, long long doubledLowerBound) {
+    // Time complexity: O(V^2)
+
+    int numCandidates = search.numVertices - depth;
+    int bestRow = 0;
+    int bestRowNumSurvivors = std::numeric_limits<int>::max();
+    for (int row = 0; row < numCandidates && bestRowNumSurvivors > 1; row++) {
+        int numSurvivors = 0;
+        for (int column = 0; column < numCandidates; column++) {
+            long long reducedCost = linearAssignmentReducedCost(search.linearAssignment, search.assignmentCost.data(), numCandidates, row, column);
+            if (partialCost + (doubledLowerBound + reducedCost + 1) / 2 < search.bestCost) {
+                numSurvivors++;
+            }
+        }
+
+        if (numSurvivors < bestRowNumSurvivors) {
+            bestRowNumSurvivors = numSurvivors;
+            bestRow = row;
+        }
+    }
+
+    return bestRow;
+}
+
+void graphEditDistanceBranchAndBoundHelper(GraphEditDistanceBranchAndBoundSearch& search, int depth, int partialCost) {
+    int numVertices = search.numVertices;
+
+    if (search.isTimedOut) {
+        return;
+    }
+    search.numNodes++;
+    if (search.hasDeadline && (search.numNodes & 255) == 0 && std::chrono::steady_clock::now() >= search.deadline) {
+        search.isTimedOut = true;
+        return;
+    }
+
+    if (depth == numVertices) {
+        if (partialCost < search.bestCost) {
+            search.bestCost = partialCost;
+            search.bestPermutation = search.permutation;
+        }
+        return;
+    }
+
+    long long doubledLowerBound = graphEditDistanceBranchAndBoundAssignmentBound(search, depth);
+    if (partialCost + (doubledLowerBound + 1) / 2 >= search.bestCost) {
+        return;
+    }
+
+    // Reduced costs bound every child. Map next the vertex with the fewest children surviving that bound (fail first).
+    int numCandidates = numVertices - depth;
+    int bestRow = graphEditDistanceBranchAndBoundSelectRow(search, depth, partialCost, doubledLowerBound);
+
+    // The rest of the search only needs order[depth..] to be the set of not mapped vertices, so it can be reordered
+    std::swap(search.order[depth], search.order[depth + bestRow]);
+    int i = search.order[depth];
+
+    int* candidates = &search.candidates[(size_t)depth * numVertices];
+    long long* candidateBounds = &search.candidateBounds[(size_t)depth * numVertices];
+
+    for (int column = 0; column < numCandidates; column++) {
+        candidates[column] = search.unusedVertices[column];
+        candidateBounds[column] = partialCost + (doubledLowerBound + linearAssignmentReducedCost(
+            search.linearAssignment,
+            search.assignmentCost.data(),
+            numCandidates,
+            bestRow,
+            column
+        ) + 1) / 2;
+    }
+
+    // Try the most promising candidates first, so good mappings are found early
+    for (int k = 1; k < numCandidates; k++) {
+        int candidate = candidates[k];
+        long long candidateBound = candidateBounds[k];
+        int position = k;
+        while (position > 0 && candidateBounds[position - 1] > candidateBound) {
+            candidates[position] = candidates[position - 1];
+            candidateBounds[position] = candidateBounds[position - 1];
+            position--;
+        }
+        candidates[position] = candidate;
+        candidateBounds[position] = candidateBound;
+    }
+
+    for (int k = 0; k < numCandidates; k++) {
+        // Candidates are sorted by their bound, so none of the next ones can be better
+        if (candidateBounds[k] >= search.bestCost) {
+            break;
+        }
+
+        int u = candidates[k];
+        int newPartialCost = partialCost + search.crossCost[(size_t)i * numVertices + u];
+
+        search.permutation[i] = u;
+        search.isUsed[u] = 1;
+        graphEditDistanceBranchAndBoundUpdate(search, depth, i, u, 1);
+
+        graphEditDistanceBranchAndBoundHelper(search, depth + 1, newPartialCost);
+
+        graphEditDistanceBranchAndBoundUpdate(search, depth, i, u, -1);
+        search.isUsed[u] = 0;
+        search.permutation[i] = -1;
+    }
+}
+
+// Everything the search needs before the root node: multiplicity levels, the order of mapping, the buffers,
+// and the starting upper bound, the better of the given mapping and the root assignment polished by swaps.
+// search must be created as {multigraphs, multigraphs.numVertices}.
+void initGraphEditDistanceBranchAndBoundSearch(GraphEditDistanceBranchAndBoundSearch& search, const std::vector<int>& permutation) {
+    // Time complexity: O(V^2 * L + V^3) + O(V^3) per round of swaps
+    // Space complexity: O(V^2 + V * L)
+
+    const PaddedMultigraphPair& multigraphs = search.multigraphs;
+    int numVertices = search.numVertices;
+    const DenseMultigraph<int>& multigraph1 = multigraphs.multigraph1;
+    const DenseMultigraph<int>& multigraph2 = multigraphs.multigraph2;
+
+    // Distinct positive multiplicities of both multigraphs (self-loops do not count)
+    std::vector<int> levels;
+    for (int u = 0; u < numVertices; u++) {
+        for (int w = 0; w < numVertices; w++) {
+            if (u == w) {
+                continue;
+            }
+            if (multigraph1[u][w] > 0) {
+                levels.push_back(multigraph1[u][w]);
+            }
+            if (multigraph2[u][w] > 0) {
+                levels.push_back(multigraph2[u][w]);
+            }
+        }
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+    search.numLevels = levels.size();
+    search.levelWeights.resize(levels.size());
+    for (int level = 0; level < search.numLevels; level++) {
+        search.levelWeights[level] = levels[level] - (level > 0 ? levels[level - 1] : 0);
+    }
+
+    search.levelIndex1 = DenseMultigraph<int>(numVertices);
+    search.levelIndex2 = DenseMultigraph<int>(numVertices);
+    search.levelCounts1.assign((size_t)numVertices * search.numLevels, 0);
+    search.levelCounts2.assign((size_t)numVertices * search.numLevels, 0);
+    for (int u = 0; u < numVertices; u++) {
+        for (int w = 0; w < numVertices; w++) {
+            if (u == w) {
+                continue;
+            }
+
+            search.levelIndex1[u][w] = std::upper_bound(levels.begin(), levels.end(), multigraph1[u][w]) - levels.begin();
+            search.levelIndex2[u][w] = std::upper_bound(levels.begin(), levels.end(), multigraph2[u][w]) - levels.begin();
+
+            for (int level = 0; level < search.levelIndex1[u][w]; level++) {
+                search.levelCounts1[(size_t)u * search.numLevels + level]++;
+            }
+            for (int level = 0; level < search.levelIndex2[u][w]; level++) {
+                search.levelCounts2[(size_t)u * search.numLevels + level]++;
+            }
+        }
+    }
+
+    std::vector<int> degrees2 = offDiagonalDegrees(multigraph2);
+    search.order.resize(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        search.order[i] = i;
+    }
+    std::stable_sort(search.order.begin(), search.order.end(), [&degrees2](int a, int b) {
+        return degrees2[a] > degrees2[b];
+    });
+
+    search.permutation.assign(numVertices, -1);
+    search.isUsed.assign(numVertices, 0);
+    search.crossCost.assign((size_t)numVertices * numVertices, 0);
+    search.assignmentCost.resize((size_t)numVertices * numVertices);
+    search.unusedVertices.resize(numVertices);
+    search.candidates.resize((size_t)numVertices * numVertices);
+    search.candidateBounds.resize((size_t)numVertices * numVertices);
+
+    // Starting upper bound
+    search.bestPermutation = permutation;
+    search.bestCost = graphEditDistanceMappingCost(multigraphs, permutation);
+
+    graphEditDistanceBranchAndBoundAssignmentBound(search, 0);
+    std::vector<int> assignmentPermutation(numVertices);
+    for (int row = 0; row < numVertices; row++) {
+        assignmentPermutation[search.order[row]] = search.unusedVertices[search.linearAssignment.rowAssignment[row]];
+    }
+
+    int assignmentCost = graphEditDistanceMappingCost(multigraphs, assignmentPermutation);
+    assignmentCost = improveMappingBySwaps(multigraphs, assignmentPermutation, assignmentCost);
+    if (assignmentCost < search.bestCost) {
+        search.bestCost = assignmentCost;
+        search.bestPermutation = assignmentPermutation;
+    }
+
+    search.hasDeadline = false;
+    search.isTimedOut = false;
+    search.numNodes = 0;
+}
+
+// Minimal edges edit distance (without the vertex count difference).
+// permutation is the starting mapping (its cost is the starting upper bound) and receives the optimal mapping.
+int graphEditDistanceBranchAndBoundEdgesCost(const PaddedMultigraphPair& multigraphs, std::vector<int>& permutation) {
+    // Time complexity: O(V^3 * V!) in the worst case, the bounds cut most of the tree in practice
+    // Space complexity: O(V^2 + V * L)
+
+    if (multigraphs.numVertices == 0) {
+        permutation.clear();
+        return 0;
+    }
+
+    GraphEditDistanceBranchAndBoundSearch search = makeGraphEditDistanceBranchAndBoundSearch(multigraphs);
+    initGraphEditDistanceBranchAndBoundSearch(search, permutation);
+
+    graphEditDistanceBranchAndBoundHelper(search, 0, 0);
+
+    permutation = search.bestPermutation;
+    return search.bestCost;
+}
+
+struct GraphEditDistanceBranchAndBoundResult {
+    // Upper bound, the graph edit distance when isExact
+    int graphEditDistance;
+    // False when the time limit stopped the search
+    bool isExact;
+    long long numNodes;
+};
+
+// timeLimitMilliseconds <= 0 means no time limit
+template <typename Multigraph>
+GraphEditDistanceBranchAndBoundResult graphEditDistanceBranchAndBoundWithTimeLimit(const Multigraph& multigraph1, const Multigraph& multigraph2, long long timeLimitMilliseconds) {
+    // Time complexity: O(V^3 * V!) in the worst case
+    // Space complexity: O(V^2 + V * L)
+
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    if (multigraphs.numVertices == 0) {
+        return {multigraphs.vertexCountDifference, true, 0};
+    }
+
+    GraphEditDistanceBranchAndBoundSearch search = makeGraphEditDistanceBranchAndBoundSearch(multigraphs);
+    initGraphEditDistanceBranchAndBoundSearch(search, degreeSequenceMapping(multigraphs));
+    if (timeLimitMilliseconds > 0) {
+        search.hasDeadline = true;
+        search.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMilliseconds);
+    }
+
+    graphEditDistanceBranchAndBoundHelper(search, 0, 0);
+
+    return {multigraphs.vertexCountDifference + search.bestCost, !search.isTimedOut, search.numNodes};
+}
+
+template <typename Multigraph>
+int graphEditDistanceBranchAndBound(const Multigraph& multigraph1, const Multigraph& multigraph2) {
+    return graphEditDistanceBranchAndBoundWithTimeLimit(multigraph1, multigraph2, 0).graphEditDistance;
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_BRANCH_AND_BOUND_H
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "graph_utils.h"
+#include "thread_pool.h"
+#include "graph_solution_2_polynomial_approximation.h"
+#include "graph_solution_2_branch_and_bound.h"
+#include "graph_solution_2_assignment_approximation.h"
+#include "graph_solution_2_beam_search.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_DISTANCE_MATRIX_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_DISTANCE_MATRIX_H
+
+// Graph edit distance between every pair of a collection of multigraphs.
+// The multigraphs are undirected, so only the pairs a < b are computed (d(b, a) = d(a, b), d(a, a) = 0),
+// which also keeps the matrix symmetric for the methods whose result depends on the order of the two arguments.
+// The upper triangle is cut into tileSize x tileSize tiles, handed out to the threads in row-major order from a shared
+// counter: tiles differ a lot in cost (the exact search on one hard pair), so they are balanced dynamically, and the
+// tiles of the first rows finish first. Once every tile of a tile row is done, its rows are passed to onRow in order,
+// so the output is streamed while the rest is still being computed.
+// Only the upper triangle is kept (the lower part of a row comes from the earlier rows), N (N - 1) / 2 values.
+
+enum class GraphEditDistanceMethod {
+    // graphEditDistanceBranchAndBound, an upper bound for the pairs that reach the time limit
+    Exact,
+    // Upper bound of graphEditDistanceAssignmentApproximation
+    Assignment,
+    // graphEditDistanceBeamSearch
+    BeamSearch,
+    // graphEditDistancePolynomialApproximation
+    DegreeSequence
+};
+
+enum class GraphEditDistanceMatrixFormat {
+    Csv,
+    // int32 N, then the N x N matrix as int32 row by row, native byte order
+    Binary
+};
+
+// Returns false when the name is unknown
+bool parseGraphEditDistanceMethod(const std::string& name, GraphEditDistanceMethod& method) {
+    if (name == "exact") {
+        method = GraphEditDistanceMethod::Exact;
+    } else if (name == "assignment") {
+        method = GraphEditDistanceMethod::Assignment;
+    } else if (name == "beam") {
+        method = GraphEditDistanceMethod::BeamSearch;
+    } else if (name == "degree") {
+        method = GraphEditDistanceMethod::DegreeSequence;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* graphEditDistanceMethodName(GraphEditDistanceMethod method) {
+    switch (method) {
+        case GraphEditDistanceMethod::Exact:
+            return "exact";
+        case GraphEditDistanceMethod::Assignment:
+            return "assignment";
+        case GraphEditDistanceMethod::BeamSearch:
+            return "beam";
+        default:
+            return "degree";
+    }
+}
+
+bool parseGraphEditDistanceMatrixFormat(const std::string& name, GraphEditDistanceMatrixFormat& format) {
+    if (name == "csv") {
+        format = GraphEditDistanceMatrixFormat::Csv;
+    } else if (name == "binary") {
+        format = GraphEditDistanceMatrixFormat::Binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// timeLimitMilliseconds bounds every pair of the exact method, <= 0 means no time limit
+template <typename Multigraph>
+std::function<int(const Multigraph&, const Multigraph&)> makeGraphEditDistanceFunction(GraphEditDistanceMethod method, int beamWidth, long long timeLimitMilliseconds = 0) {
+    switch (method) {
+        case GraphEditDistanceMethod::Exact:
+            return [timeLimitMilliseconds](const Multigraph& multigraph1, const Multigraph& multigraph2) {
+                return graphEditDistanceBranchAndBoundWithTimeLimit(multigraph1, multigraph2, timeLimitMilliseconds).graphEditDistance;
+            };
+        case GraphEditDistanceMethod::Assignment:
+            return [](const Multigraph& multigraph1, const Multigraph& multigraph2) {
+                return graphEditDistanceAssignmentApproximation(multigraph1, multigraph2).upperBound;
+            };
+        case GraphEditDistanceMethod::BeamSearch:
+            return [beamWidth](const Multigraph& multigraph1, const Multigraph& multigraph2) {
+                return graphEditDistanceBeamSearch(multigraph1, multigraph2, beamWidth);
+            };
+        default:
+            return [](const Multigraph& multigraph1, const Multigraph& multigraph2) {
+                return graphEditDistancePolynomialApproximation(multigraph1, multigraph2);
+            };
+    }
+}
+
+void writeGraphEditDistanceMatrixHeader(std::ostream& output, GraphEditDistanceMatrixFormat format, int numGraphs) {
+    if (format == GraphEditDistanceMatrixFormat::Binary) {
+        int32_t size = numGraphs;
+        output.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+}
+
+void writeGraphEditDistanceMatrixRow(std::ostream& output, GraphEditDistanceMatrixFormat format, const std::vector<int>& row) {
+    if (format == GraphEditDistanceMatrixFormat::Binary) {
+        std::vector<int32_t> values(row.begin(), row.end());
+        output.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32_t));
+        return;
+    }
+
+    std::string line;
+    for (int j = 0; j < (int)row.size(); j++) {
+        if (j > 0) {
+            line += ',';
+        }
+        line += std::to_string(row[j]);
+    }
+    line += '\n';
+    output << line;
+}
+
+// Index of the pair a < b in the upper triangle stored row by row
+size_t graphEditDistanceMatrixPairIndex(int numGraphs, int a, int b) {
+    return (size_t)a * numGraphs - (size_t)a * (a + 1) / 2 + (b - a - 1);
+}
+
+// onRow(a, row) receives the rows in order, row[b] = d(a, b)
+template <typename Multigraph>
+void graphEditDistanceMatrix(
+    const std::vector<Multigraph>& multigraphs,
+    const std::function<int(const Multigraph&, const Multigraph&)>& graphEditDistanceFunction,
+    int threadCount,
+    int tileSize,
+    const std::function<void(int, const std::vector<int>&)>& onRow
+) {
+    // Time complexity: O(N^2 / 2 * T(graphEditDistanceFunction) / threadCount)
+    // Space complexity: O(N^2 / 2)
+
+    int numGraphs = multigraphs.size();
+    tileSize = std::max(1, tileSize);
+    int numTileRows = (numGraphs + tileSize - 1) / tileSize;
+
+    std::vector<int> upperTriangle((size_t)numGraphs * std::max(0, numGraphs - 1) / 2);
+
+    // Tiles (tileRow, tileColumn) with tileColumn >= tileRow, numbered row by row
+    std::vector<int> tileRowFirstTile(numTileRows + 1, 0);
+    for (int tileRow = 0; tileRow < numTileRows; tileRow++) {
+        tileRowFirstTile[tileRow + 1] = tileRowFirstTile[tileRow] + (numTileRows - tileRow);
+    }
+    int numTiles = tileRowFirstTile[numTileRows];
+
+    std::atomic<int> nextTile(0);
+    std::vector<int> remainingTiles(numTileRows);
+    for (int tileRow = 0; tileRow < numTileRows; tileRow++) {
+        remainingTiles[tileRow] = numTileRows - tileRow;
+    }
+    std::mutex remainingTilesMutex;
+    std::condition_variable tileRowDone;
+
+    auto computeTile = [&](int tile) {
+        int tileRow = std::upper_bound(tileRowFirstTile.begin(), tileRowFirstTile.end(), tile) - tileRowFirstTile.begin() - 1;
+        int tileColumn = tileRow + (tile - tileRowFirstTile[tileRow]);
+
+        int rowEnd = std::min(numGraphs, (tileRow + 1) * tileSize);
+        int columnEnd = std::min(numGraphs, (tileColumn + 1) * tileSize);
+        for (int a = tileRow * tileSize; a < rowEnd; a++) {
+            for (int b = std::max(a + 1, tileColumn * tileSize); b < columnEnd; b++) {
+                upperTriangle[graphEditDistanceMatrixPairIndex(numGraphs, a, b)] = graphEditDistanceFunction(multigraphs[a], multigraphs[b]);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(remainingTilesMutex);
+            remainingTiles[tileRow]--;
+        }
+        tileRowDone.notify_all();
+    };
+
+    auto worker = [&]() {
+        for (int tile = nextTile++; tile < numTiles; tile = nextTile++) {
+            computeTile(tile);
+        }
+    };
+
+    // The calling thread streams the rows while the pool computes the tiles
+    WorkStealingThreadPool threadPool(threadCount);
+    for (int i = 0; i < threadPool.size(); i++) {
+        threadPool.submit(worker);
+    }
+
+    std::vector<int> row(numGraphs);
+    for (int tileRow = 0; tileRow < numTileRows; tileRow++) {
+        {
+            std::unique_lock<std::mutex> lock(remainingTilesMutex);
+            tileRowDone.wait(lock, [&remainingTiles, tileRow]() {
+                return remainingTiles[tileRow] == 0;
+            });
+        }
+
+        int rowEnd = std::min(numGraphs, (tileRow + 1) * tileSize);
+        for (int a = tileRow * tileSize; a < rowEnd; a++) {
+            for (int b = 0; b < numGraphs; b++) {
+                if (a == b) {
+                    row[b] = 0;
+                } else {
+                    row[b] = upperTriangle[graphEditDistanceMatrixPairIndex(numGraphs, std::min(a, b), std::max(a, b))];
+                }
+            }
+            onRow(a, row);
+        }
+    }
+
+    threadPool.wait();
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_DISTANCE_MATRIX_H
@@ -18,7 +18,8 @@
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_POLYNOMIAL_APPROXIMATION_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_2_POLYNOMIAL_APPROXIMATION_H
 
-int graphEditDistancePolynomialApproximation(const MultigraphAdjacencyMatrix& multigraph1, const MultigraphAdjacencyMatrix& multigraph2){
+template <typename Multigraph>
+int graphEditDistancePolynomialApproximation(const Multigraph& multigraph1, const Multigraph& multigraph2){
     auto size1 = size(multigraph1);
     auto size2 = size(multigraph2);
 
@@ -0,0 +1,299 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <stdexcept>
+
+#include "graph_utils.h"
+#include "graph_solution_2_distance_matrix.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_VP_TREE_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_VP_TREE_H
+
+// Vantage-point tree over a corpus of multigraphs, for nearest neighbour and range queries by graph edit distance.
+// Every node holds one multigraph of the corpus (the vantage point) and the median distance from it to the rest
+// of its subtree: the ones at most that far go inside, the others outside. A query at distance d from the vantage point
+// looking for everything within tau can skip, by the triangle inequality,
+// 1. the inside when d - radius > tau (everything inside is at least d - radius away)
+// 2. the outside when radius + 1 - d > tau (everything outside is at least radius + 1 - d away)
+// so only a small part of the corpus is compared with the query.
+// The exact graph edit distance is a metric (a pseudometric, self-loops do not count); with an approximation the
+// triangle inequality may not hold and a query may miss some neighbours, which is the trade-off the method selects.
+// The index file is a graph file with the corpus (readable by every other command), followed by the tree:
+//   vp-tree <method> <beam width>
+//   <root> <node count>
+//   <graph> <radius> <inside> <outside>    one line per node, -1 for no child
+
+struct GraphEditDistanceVpTreeNode {
+    int graph;
+    int radius;
+    int inside;
+    int outside;
+};
+
+struct GraphEditDistanceVpTree {
+    GraphEditDistanceMethod method;
+    int beamWidth;
+    std::vector<MultigraphAdjacencyMatrix> multigraphs;
+    std::vector<GraphEditDistanceVpTreeNode> nodes;
+    int root;
+};
+
+struct GraphEditDistanceNeighbour {
+    int graph;
+    int distance;
+};
+
+bool operator<(const GraphEditDistanceNeighbour& a, const GraphEditDistanceNeighbour& b) {
+    if (a.distance != b.distance) {
+        return a.distance < b.distance;
+    }
+    return a.graph < b.graph;
+}
+
+struct GraphEditDistanceVpTreeQueryResult {
+    // Closest first
+    std::vector<GraphEditDistanceNeighbour> neighbours;
+    long long numDistanceEvaluations;
+};
+
+// Builds the subtree over graphs[begin..end), returns its node
+int buildGraphEditDistanceVpTreeHelper(
+    GraphEditDistanceVpTree& tree,
+    const std::function<int(const MultigraphAdjacencyMatrix&, const MultigraphAdjacencyMatrix&)>& graphEditDistanceFunction,
+    std::vector<GraphEditDistanceNeighbour>& graphs,
+    int begin,
+    int end
+) {
+    if (begin == end) {
+        return -1;
+    }
+
+    int node = tree.nodes.size();
+    int vantagePoint = graphs[begin].graph;
+    tree.nodes.push_back({vantagePoint, 0, -1, -1});
+    begin++;
+
+    if (begin == end) {
+        return node;
+    }
+
+    for (int k = begin; k < end; k++) {
+        graphs[k].distance = graphEditDistanceFunction(tree.multigraphs[vantagePoint], tree.multigraphs[graphs[k].graph]);
+    }
+
+    // The median goes inside, so both halves are non empty unless the distances are all equal
+    int middle = begin + (end - begin - 1) / 2;
+    std::nth_element(graphs.begin() + begin, graphs.begin() + middle, graphs.begin() + end);
+    int radius = graphs[middle].distance;
+    int split = std::partition(graphs.begin() + begin, graphs.begin() + end, [radius](const GraphEditDistanceNeighbour& neighbour) {
+        return neighbour.distance <= radius;
+    }) - graphs.begin();
+
+    int inside = buildGraphEditDistanceVpTreeHelper(tree, graphEditDistanceFunction, graphs, begin, split);
+    int outside = buildGraphEditDistanceVpTreeHelper(tree, graphEditDistanceFunction, graphs, split, end);
+
+    tree.nodes[node].radius = radius;
+    tree.nodes[node].inside = inside;
+    tree.nodes[node].outside = outside;
+    return node;
+}
+
+GraphEditDistanceVpTree buildGraphEditDistanceVpTree(std::vector<MultigraphAdjacencyMatrix> multigraphs, GraphEditDistanceMethod method, int beamWidth) {
+    // Time complexity: O(N log N) distance evaluations on average
+    // Space complexity: O(N)
+
+    GraphEditDistanceVpTree tree = {
+        method,
+        beamWidth,
+        std::move(multigraphs),
+        {},
+        -1
+    };
+
+    // Vantage points in a fixed random order, so the tree does not depend on how the corpus is sorted
+    std::vector<GraphEditDistanceNeighbour> graphs;
+    for (int i = 0; i < (int)tree.multigraphs.size(); i++) {
+        graphs.push_back({i, 0});
+    }
+    std::mt19937 generator(0);
+    std::shuffle(graphs.begin(), graphs.end(), generator);
+
+    auto graphEditDistanceFunction = makeGraphEditDistanceFunction<MultigraphAdjacencyMatrix>(method, beamWidth);
+    tree.root = buildGraphEditDistanceVpTreeHelper(tree, graphEditDistanceFunction, graphs, 0, graphs.size());
+
+    return tree;
+}
+
+// Search state shared by the k nearest neighbours and the range query:
+// the best found so far are kept in a max-heap of at most maxNeighbours, within maxDistance
+struct GraphEditDistanceVpTreeSearch {
+    const GraphEditDistanceVpTree& tree;
+    const MultigraphAdjacencyMatrix& query;
+    const std::function<int(const MultigraphAdjacencyMatrix&, const MultigraphAdjacencyMatrix&)>& graphEditDistanceFunction;
+    size_t maxNeighbours;
+    int maxDistance;
+    std::priority_queue<GraphEditDistanceNeighbour> neighbours;
+    long long numDistanceEvaluations;
+};
+
+// Largest distance a new neighbour may have
+int graphEditDistanceVpTreeSearchRadius(const GraphEditDistanceVpTreeSearch& search) {
+    if (search.neighbours.size() < search.maxNeighbours) {
+        return search.maxDistance;
+    }
+    return std::min(search.maxDistance, search.neighbours.top().distance - 1);
+}
+
+void graphEditDistanceVpTreeSearchHelper(GraphEditDistanceVpTreeSearch& search, int nodeIndex) {
+    if (nodeIndex == -1) {
+        return;
+    }
+
+    const GraphEditDistanceVpTreeNode& node = search.tree.nodes[nodeIndex];
+    int distance = search.graphEditDistanceFunction(search.tree.multigraphs[node.graph], search.query);
+    search.numDistanceEvaluations++;
+
+    if (distance <= graphEditDistanceVpTreeSearchRadius(search)) {
+        search.neighbours.push({node.graph, distance});
+        if (search.neighbours.size() > search.maxNeighbours) {
+            search.neighbours.pop();
+        }
+    }
+
+    // The side the query falls on first, it is the likelier one to shrink the radius
+    if (distance <= node.radius) {
+        if (distance - node.radius <= graphEditDistanceVpTreeSearchRadius(search)) {
+            graphEditDistanceVpTreeSearchHelper(search, node.inside);
+        }
+        if (node.radius + 1 - distance <= graphEditDistanceVpTreeSearchRadius(search)) {
+            graphEditDistanceVpTreeSearchHelper(search, node.outside);
+        }
+    } else {
+        if (node.radius + 1 - distance <= graphEditDistanceVpTreeSearchRadius(search)) {
+            graphEditDistanceVpTreeSearchHelper(search, node.outside);
+        }
+        if (distance - node.radius <= graphEditDistanceVpTreeSearchRadius(search)) {
+            graphEditDistanceVpTreeSearchHelper(search, node.inside);
+        }
+    }
+}
+
+// The maxNeighbours closest multigraphs of the corpus that are at most maxDistance away from the query
+GraphEditDistanceVpTreeQueryResult queryGraphEditDistanceVpTree(const GraphEditDistanceVpTree& tree, const MultigraphAdjacencyMatrix& query, size_t maxNeighbours, int maxDistance) {
+    // Time complexity: O(N) distance evaluations in the worst case, O(log N) for close neighbours in a spread out corpus
+
+    auto graphEditDistanceFunction = makeGraphEditDistanceFunction<MultigraphAdjacencyMatrix>(tree.method, tree.beamWidth);
+    GraphEditDistanceVpTreeSearch search = {
+        tree,
+        query,
+        graphEditDistanceFunction,
+        maxNeighbours,
+        maxDistance,
+        {},
+        0
+    };
+
+    if (maxNeighbours > 0) {
+        graphEditDistanceVpTreeSearchHelper(search, tree.root);
+    }
+
+    GraphEditDistanceVpTreeQueryResult result = {{}, search.numDistanceEvaluations};
+    while (!search.neighbours.empty()) {
+        result.neighbours.push_back(search.neighbours.top());
+        search.neighbours.pop();
+    }
+    std::reverse(result.neighbours.begin(), result.neighbours.end());
+
+    return result;
+}
+
+GraphEditDistanceVpTreeQueryResult graphEditDistanceNearestNeighbours(const GraphEditDistanceVpTree& tree, const MultigraphAdjacencyMatrix& query, int k) {
+    return queryGraphEditDistanceVpTree(tree, query, std::max(0, k), std::numeric_limits<int>::max());
+}
+
+GraphEditDistanceVpTreeQueryResult graphEditDistanceRangeQuery(const GraphEditDistanceVpTree& tree, const MultigraphAdjacencyMatrix& query, int maxDistance) {
+    return queryGraphEditDistanceVpTree(tree, query, tree.multigraphs.size(), maxDistance);
+}
+
+void writeGraphEditDistanceVpTreeToFile(const std::string& filename, const GraphEditDistanceVpTree& tree) {
+    std::ofstream outputFile(filename);
+    if (!outputFile.is_open()) {
+        std::cout << "Error: cannot open file " << filename << std::endl;
+        throw std::runtime_error("Cannot open file");
+    }
+
+    outputFile << tree.multigraphs.size() << std::endl;
+    for (auto& multigraph : tree.multigraphs) {
+        writeGraph(outputFile, multigraph);
+        outputFile << std::endl;
+    }
+
+    outputFile << "vp-tree " << graphEditDistanceMethodName(tree.method) << " " << tree.beamWidth << std::endl;
+    outputFile << tree.root << " " << tree.nodes.size() << std::endl;
+    for (auto& node : tree.nodes) {
+        outputFile << node.graph << " " << node.radius << " " << node.inside << " " << node.outside << std::endl;
+    }
+}
+
+GraphEditDistanceVpTree readGraphEditDistanceVpTreeFromFile(const std::string& filename) {
+    std::ifstream inputFile(filename);
+    if (!inputFile.is_open()) {
+        std::cout << "Error: cannot open file " << filename << std::endl;
+        throw std::runtime_error("Cannot open file");
+    }
+
+    GraphEditDistanceVpTree tree;
+
+    int graphCount;
+    inputFile >> graphCount;
+    for (int i = 0; i < graphCount; i++) {
+        tree.multigraphs.push_back(readGraph(inputFile, false).multigraph);
+    }
+
+    std::string tag;
+    std::string methodName;
+    inputFile >> tag >> methodName >> tree.beamWidth;
+    if (tag != "vp-tree" || !parseGraphEditDistanceMethod(methodName, tree.method)) {
+        std::cout << "Error: " << filename << " is not a vp-tree index" << std::endl;
+        throw std::runtime_error("Not a vp-tree index");
+    }
+
+    int nodeCount;
+    inputFile >> tree.root >> nodeCount;
+    if (!inputFile || nodeCount < 0 || nodeCount > (int)tree.multigraphs.size() || tree.beamWidth < 1) {
+        std::cout << "Error: " << filename << " is not a vp-tree index" << std::endl;
+        throw std::runtime_error("Not a vp-tree index");
+    }
+
+    tree.nodes.resize(nodeCount);
+    for (auto& node : tree.nodes) {
+        inputFile >> node.graph >> node.radius >> node.inside >> node.outside;
+    }
+    if (!inputFile) {
+        std::cout << "Error: " << filename << " is not a vp-tree index" << std::endl;
+        throw std::runtime_error("Not a vp-tree index");
+    }
+
+    // Every index in range, and the children come after their node as the builder numbers them, so there is no cycle
+    bool isValid = nodeCount == 0 ? tree.root == -1 : tree.root == 0;
+    for (int k = 0; k < nodeCount && isValid; k++) {
+        const GraphEditDistanceVpTreeNode& node = tree.nodes[k];
+        isValid = node.graph >= 0 && node.graph < (int)tree.multigraphs.size()
+            && (node.inside == -1 || (node.inside > k && node.inside < nodeCount))
+            && (node.outside == -1 || (node.outside > k && node.outside < nodeCount));
+    }
+    if (!isValid) {
+        std::cout << "Error: " << filename << " is a corrupt vp-tree index" << std::endl;
+        throw std::runtime_error("Corrupt vp-tree index");
+    }
+
+    return tree;
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_VP_TREE_H
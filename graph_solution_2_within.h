@@ -0,0 +1,194 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "graph_utils.h"
+#include "dense_multigraph.h"
+#include "graph_edit_distance_utils.h"
+#include "graph_solution_2_assignment_approximation.h"
+#include "graph_solution_2_branch_and_bound.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_2_WITHIN_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_2_WITHIN_H
+
+// Is GED(multigraph1, multigraph2) <= threshold? Answered by a cascade of bounds, cheapest first,
+// the exact search only runs when none of them decides:
+// 1. vertex count: GED >= |V1 - V2|
+// 2. edge count: the edges cost is at least |E1 - E2| (self-loops excluded)
+// 3. degree sequence: half of the distance between the sorted degree sequences
+//    (the admissible form of graphEditDistancePolynomialApproximation, see graph_edit_distance_utils.h)
+// 4. multiplicity histogram: every mapping pairs the vertex pairs of both multigraphs one to one, so the edges cost is
+//    at least the distance between the sorted lists of pair multiplicities (always at least the edge count bound)
+// 5. assignment: lower and upper bound of graphEditDistanceAssignmentApproximation, the upper bound can accept
+// 6. exact: branch and bound started with the threshold as the best cost, so it only has to find one mapping under it
+// 2-5 read every vertex pair from one side of the matrix, while graphEditDistance reads either side depending on
+// the mapping, so for a non symmetric input file only the vertex count and the upper bounds are used.
+// 1-4 only need a per-multigraph signature, so in bulk queries every multigraph is summarised once
+// and a rejected pair costs O(V + E) instead of O(V^2).
+
+enum class GraphEditDistanceFilterStage {
+    VertexCount,
+    EdgeCount,
+    DegreeSequence,
+    MultiplicityHistogram,
+    Assignment,
+    Exact
+};
+
+const char* graphEditDistanceFilterStageName(GraphEditDistanceFilterStage stage) {
+    switch (stage) {
+        case GraphEditDistanceFilterStage::VertexCount:
+            return "vertex count";
+        case GraphEditDistanceFilterStage::EdgeCount:
+            return "edge count";
+        case GraphEditDistanceFilterStage::DegreeSequence:
+            return "degree sequence";
+        case GraphEditDistanceFilterStage::MultiplicityHistogram:
+            return "multiplicity histogram";
+        case GraphEditDistanceFilterStage::Assignment:
+            return "assignment";
+        default:
+            return "exact";
+    }
+}
+
+struct GraphEditDistanceFilterSignature {
+    int numVertices;
+    bool isSymmetric;
+    // Without self-loops
+    int numEdges;
+    // Degrees without self-loops, in decreasing order
+    std::vector<int> degrees;
+    // Positive multiplicities of the pairs i < j, in decreasing order
+    std::vector<int> pairMultiplicities;
+};
+
+struct GraphEditDistanceWithinResult {
+    bool isWithin;
+    GraphEditDistanceFilterStage decidedBy;
+};
+
+template <typename Multigraph>
+GraphEditDistanceFilterSignature makeGraphEditDistanceFilterSignature(const Multigraph& multigraph) {
+    // Time complexity: O(V^2 + E log E)
+
+    int numVertices = multigraph.size();
+
+    // size() counts the self-loops too, the graph edit distance does not
+    int numEdges = size(multigraph).numEdges;
+    for (int i = 0; i < numVertices; i++) {
+        numEdges -= multigraph[i][i];
+    }
+
+    bool isSymmetric = true;
+    std::vector<int> degrees(numVertices, 0);
+    std::vector<int> pairMultiplicities;
+    for (int i = 0; i < numVertices; i++) {
+        for (int j = 0; j < numVertices; j++) {
+            if (i == j) {
+                continue;
+            }
+            if (multigraph[i][j] != multigraph[j][i]) {
+                isSymmetric = false;
+            }
+            degrees[i] += multigraph[i][j];
+            if (i < j && multigraph[i][j] > 0) {
+                pairMultiplicities.push_back(multigraph[i][j]);
+            }
+        }
+    }
+    std::sort(degrees.begin(), degrees.end(), std::greater<int>());
+    std::sort(pairMultiplicities.begin(), pairMultiplicities.end(), std::greater<int>());
+
+    return {
+        numVertices,
+        isSymmetric,
+        numEdges,
+        degrees,
+        pairMultiplicities
+    };
+}
+
+// Sum of |a_k - b_k| over two lists sorted in decreasing order, the shorter one padded with zeros
+long long sortedListsDistance(const std::vector<int>& list1, const std::vector<int>& list2) {
+    // Time complexity: O(max(|list1|, |list2|))
+
+    const std::vector<int>& longer = list1.size() >= list2.size() ? list1 : list2;
+    const std::vector<int>& shorter = list1.size() >= list2.size() ? list2 : list1;
+
+    long long distance = 0;
+    for (int k = 0; k < (int)longer.size(); k++) {
+        distance += std::abs(longer[k] - (k < (int)shorter.size() ? shorter[k] : 0));
+    }
+
+    return distance;
+}
+
+template <typename Multigraph>
+GraphEditDistanceWithinResult graphEditDistanceWithin(
+    const Multigraph& multigraph1,
+    const GraphEditDistanceFilterSignature& signature1,
+    const Multigraph& multigraph2,
+    const GraphEditDistanceFilterSignature& signature2,
+    int threshold
+) {
+    // Time complexity: O(V + E) for the signature bounds, O(V^3) for the assignment, exponential for the exact search
+
+    long long vertexCountDifference = std::abs(signature1.numVertices - signature2.numVertices);
+    if (vertexCountDifference > threshold) {
+        return {false, GraphEditDistanceFilterStage::VertexCount};
+    }
+
+    bool isSymmetric = signature1.isSymmetric && signature2.isSymmetric;
+
+    if (isSymmetric && vertexCountDifference + std::abs(signature1.numEdges - signature2.numEdges) > threshold) {
+        return {false, GraphEditDistanceFilterStage::EdgeCount};
+    }
+
+    if (isSymmetric && vertexCountDifference + (sortedListsDistance(signature1.degrees, signature2.degrees) + 1) / 2 > threshold) {
+        return {false, GraphEditDistanceFilterStage::DegreeSequence};
+    }
+
+    if (isSymmetric && vertexCountDifference + sortedListsDistance(signature1.pairMultiplicities, signature2.pairMultiplicities) > threshold) {
+        return {false, GraphEditDistanceFilterStage::MultiplicityHistogram};
+    }
+
+    GraphEditDistanceApproximation approximation = graphEditDistanceAssignmentApproximation(multigraph1, multigraph2);
+    if (isSymmetric && approximation.lowerBound > threshold) {
+        return {false, GraphEditDistanceFilterStage::Assignment};
+    }
+    if (approximation.upperBound <= threshold) {
+        return {true, GraphEditDistanceFilterStage::Assignment};
+    }
+
+    // Only mappings with an edges cost of at most maxEdgesCost matter, everything above it is pruned
+    PaddedMultigraphPair multigraphs = makePaddedMultigraphPair(multigraph1, multigraph2);
+    int maxEdgesCost = threshold - multigraphs.vertexCountDifference;
+
+    GraphEditDistanceBranchAndBoundSearch search = makeGraphEditDistanceBranchAndBoundSearch(multigraphs);
+    initGraphEditDistanceBranchAndBoundSearch(search, approximation.permutation);
+    if (search.bestCost <= maxEdgesCost) {
+        return {true, GraphEditDistanceFilterStage::Exact};
+    }
+
+    search.bestCost = maxEdgesCost + 1;
+    graphEditDistanceBranchAndBoundHelper(search, 0, 0);
+
+    return {search.bestCost <= maxEdgesCost, GraphEditDistanceFilterStage::Exact};
+}
+
+template <typename Multigraph>
+GraphEditDistanceWithinResult graphEditDistanceWithin(const Multigraph& multigraph1, const Multigraph& multigraph2, int threshold) {
+    return graphEditDistanceWithin(
+        multigraph1,
+        makeGraphEditDistanceFilterSignature(multigraph1),
+        multigraph2,
+        makeGraphEditDistanceFilterSignature(multigraph2),
+        threshold
+    );
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_2_WITHIN_H
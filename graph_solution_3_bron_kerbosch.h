@@ -0,0 +1,242 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <climits>
+
+#include "graph_utils.h"
+#include "graph_solution_3.h"
+#include "bitset_adjacency.h"
+#include "clique_colouring_bounds.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_3_BRON_KERBOSCH_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_3_BRON_KERBOSCH_H
+
+// Exact maximal clique by Bron-Kerbosch on the support graph (u ~ v iff edgeMultiplicity(multigraph, u, v) > 0, self-loops ignored).
+// 1. Tomita pivoting: only the candidates not adjacent to the pivot are branched on, the pivot maximises |P ∩ N(pivot)|
+// 2. Degeneracy ordering of the outer level: every top level candidate set has at most d vertices (d = degeneracy),
+//    which keeps sparse inputs with thousands of vertices tractable
+// 3. Branch and bound on (n, alpha): a clique can grow to at most |R| + |P| vertices (and |R| + colours needed by P,
+//    see clique_colouring_bounds.h), and its alpha can only drop, so branches that cannot beat the best (n, alpha) so far are cut
+// Every maximum clique is maximal, so it is reached unless cut, and among them the one with the largest alpha is kept.
+
+struct BronKerboschSearch {
+    BitsetAdjacency adjacency;
+
+    // Candidate (P), excluded (X) and branching sets of every recursion depth, wordsPerRow words each
+    std::vector<BitsetWord> candidateSets;
+    std::vector<BitsetWord> excludedSets;
+    std::vector<BitsetWord> branchSets;
+    // Scratch bitsets of the colouring bound (two sets of wordsPerRow words)
+    std::vector<BitsetWord> colouringScratch;
+
+    std::vector<int> currentClique;
+    CompleteMultigraph largestCompleteMultigraph;
+    std::vector<int> largestCompleteMultigraphSelection;
+};
+
+template <typename Multigraph>
+void bronKerboschPivotHelper(const Multigraph& multigraph, BronKerboschSearch& search, int depth, int currentAlpha) {
+    int numWords = search.adjacency.wordsPerRow;
+    BitsetWord* candidates = &search.candidateSets[(size_t)depth * numWords];
+    BitsetWord* excluded = &search.excludedSets[(size_t)depth * numWords];
+    BitsetWord* branchVertices = &search.branchSets[(size_t)depth * numWords];
+
+    int currentSize = search.currentClique.size();
+    int potentialSize = currentSize + bitsetCount(candidates, numWords);
+
+    // Even taking every candidate cannot beat the best clique
+    if (potentialSize < search.largestCompleteMultigraph.n) {
+        return;
+    }
+    if (potentialSize == search.largestCompleteMultigraph.n && currentAlpha <= search.largestCompleteMultigraph.alpha) {
+        return;
+    }
+
+    // A tighter bound: the candidates cannot hold a clique larger than the number of colours they need
+    if (potentialSize > currentSize) {
+        potentialSize = currentSize + greedyColouringBound(
+            search.adjacency,
+            candidates,
+            &search.colouringScratch[0],
+            &search.colouringScratch[numWords]
+        );
+
+        if (potentialSize < search.largestCompleteMultigraph.n) {
+            return;
+        }
+        if (potentialSize == search.largestCompleteMultigraph.n && currentAlpha <= search.largestCompleteMultigraph.alpha) {
+            return;
+        }
+    }
+
+    if (bitsetIsEmpty(candidates, numWords)) {
+        // R is a maximal clique (complete multigraphs start at 2 vertices)
+        if (bitsetIsEmpty(excluded, numWords) && currentSize >= 2) {
+            search.largestCompleteMultigraph = {currentAlpha, currentSize};
+            search.largestCompleteMultigraphSelection = search.currentClique;
+        }
+        return;
+    }
+
+    // Pivot from P ∪ X with the most neighbours in P
+    int pivot = -1;
+    int pivotNumNeighbours = -1;
+    auto considerPivot = [&search, candidates, numWords, &pivot, &pivotNumNeighbours](int u) {
+        int numNeighbours = bitsetCountIntersection(candidates, search.adjacency[u], numWords);
+        if (numNeighbours > pivotNumNeighbours) {
+            pivotNumNeighbours = numNeighbours;
+            pivot = u;
+        }
+    };
+    bitsetForEach(candidates, numWords, considerPivot);
+    bitsetForEach(excluded, numWords, considerPivot);
+
+    // Only P \ N(pivot) is branched on
+    bitsetDifference(branchVertices, candidates, search.adjacency[pivot], numWords);
+
+    BitsetWord* nextCandidates = &search.candidateSets[(size_t)(depth + 1) * numWords];
+    BitsetWord* nextExcluded = &search.excludedSets[(size_t)(depth + 1) * numWords];
+
+    bitsetForEach(branchVertices, numWords, [&](int v) {
+        const BitsetWord* neighbours = search.adjacency[v];
+        bitsetIntersect(nextCandidates, candidates, neighbours, numWords);
+        bitsetIntersect(nextExcluded, excluded, neighbours, numWords);
+
+        int nextAlpha = currentAlpha;
+        for (int u : search.currentClique) {
+            nextAlpha = std::min(nextAlpha, edgeMultiplicity(multigraph, v, u));
+        }
+
+        search.currentClique.push_back(v);
+        bronKerboschPivotHelper(multigraph, search, depth + 1, nextAlpha);
+        search.currentClique.pop_back();
+
+        // P = P \ {v}, X = X ∪ {v}
+        bitsetReset(candidates, v);
+        bitsetSet(excluded, v);
+    });
+}
+
+// Vertices in the order of repeatedly removing a vertex of minimal remaining degree
+std::vector<int> degeneracyOrdering(const std::vector<std::vector<int>>& neighbours) {
+    // Time complexity: O(V + E)
+
+    int numVertices = neighbours.size();
+    int maxDegree = 0;
+    std::vector<int> degrees(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        degrees[v] = neighbours[v].size();
+        maxDegree = std::max(maxDegree, degrees[v]);
+    }
+
+    // Bucket queue with lazy deletion
+    std::vector<std::vector<int>> buckets(maxDegree + 1);
+    for (int v = 0; v < numVertices; v++) {
+        buckets[degrees[v]].push_back(v);
+    }
+
+    std::vector<char> isRemoved(numVertices, 0);
+    std::vector<int> ordering;
+    ordering.reserve(numVertices);
+
+    int currentDegree = 0;
+    while ((int)ordering.size() < numVertices) {
+        while (buckets[currentDegree].empty()) {
+            currentDegree++;
+        }
+
+        int v = buckets[currentDegree].back();
+        buckets[currentDegree].pop_back();
+        if (isRemoved[v] || degrees[v] != currentDegree) {
+            continue;
+        }
+
+        isRemoved[v] = 1;
+        ordering.push_back(v);
+
+        for (int u : neighbours[v]) {
+            if (!isRemoved[u]) {
+                degrees[u]--;
+                buckets[degrees[u]].push_back(u);
+                currentDegree = std::min(currentDegree, degrees[u]);
+            }
+        }
+    }
+
+    return ordering;
+}
+
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueBronKerbosch(const Multigraph& multigraph) {
+    // Time complexity: O(d * V * 3^(d / 3)) where d is the degeneracy of the support graph
+    // Space complexity: O(V^2 / 64)
+
+    int numVertices = multigraph.size();
+
+    BronKerboschSearch search;
+    search.adjacency = makeBitsetAdjacency(multigraph);
+    search.largestCompleteMultigraph = {0, 0};
+
+    int numWords = search.adjacency.wordsPerRow;
+    std::vector<std::vector<int>> neighbours(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        bitsetForEach(search.adjacency[v], numWords, [&neighbours, v](int u) {
+            neighbours[v].push_back(u);
+        });
+    }
+
+    std::vector<int> ordering = degeneracyOrdering(neighbours);
+    std::vector<int> position(numVertices);
+    for (int k = 0; k < numVertices; k++) {
+        position[ordering[k]] = k;
+    }
+
+    // The recursion is at most (degeneracy + 2) levels deep
+    int degeneracy = 0;
+    for (int v = 0; v < numVertices; v++) {
+        int numLaterNeighbours = 0;
+        for (int u : neighbours[v]) {
+            numLaterNeighbours += position[u] > position[v];
+        }
+        degeneracy = std::max(degeneracy, numLaterNeighbours);
+    }
+
+    size_t numLevels = degeneracy + 2;
+    search.candidateSets.assign(numLevels * numWords, 0);
+    search.excludedSets.assign(numLevels * numWords, 0);
+    search.branchSets.assign(numLevels * numWords, 0);
+    search.colouringScratch.assign(2 * (size_t)numWords, 0);
+
+    // Every clique is found from its earliest vertex in the ordering: P = later neighbours, X = earlier neighbours
+    for (int v : ordering) {
+        BitsetWord* candidates = &search.candidateSets[0];
+        BitsetWord* excluded = &search.excludedSets[0];
+        for (int k = 0; k < numWords; k++) {
+            candidates[k] = 0;
+            excluded[k] = 0;
+        }
+
+        for (int u : neighbours[v]) {
+            if (position[u] > position[v]) {
+                bitsetSet(candidates, u);
+            } else {
+                bitsetSet(excluded, u);
+            }
+        }
+
+        search.currentClique.push_back(v);
+        bronKerboschPivotHelper(multigraph, search, 0, INT_MAX);
+        search.currentClique.pop_back();
+    }
+
+    std::sort(search.largestCompleteMultigraphSelection.begin(), search.largestCompleteMultigraphSelection.end());
+
+    return {
+        search.largestCompleteMultigraph,
+        search.largestCompleteMultigraphSelection
+    };
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_3_BRON_KERBOSCH_H
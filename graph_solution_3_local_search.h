@@ -0,0 +1,259 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <climits>
+
+#include "graph_utils.h"
+#include "graph_solution_3.h"
+#include "graph_solution_3_polynomial_approximation.h"
+#include "bitset_adjacency.h"
+#include "clique_colouring_bounds.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_3_LOCAL_SEARCH_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_3_LOCAL_SEARCH_H
+
+// Anytime maximal clique: starts from the maximalCliquePolynomialApproximation result and improves it
+// by local search until the time limit, the best (alpha, n) so far is always available.
+// The greedy seeds count towards the time limit too: on a large multigraph the start may only try some of them.
+// Only the O(V^2) setup (adjacency, clique size bound) and the first seed run regardless of the limit.
+// Every iteration makes one move on the current clique C:
+// 1. add: a vertex adjacent to all of C (the one keeping alpha highest)
+// 2. swap (plateau move): a vertex adjacent to all of C but one member, which leaves C
+// 3. drop: when neither exists, the member with the weakest edges leaves C
+// Vertices that left C are tabu (cannot come back by a swap) for a few iterations, so the search does not cycle,
+// and after a long run without improvement it restarts from a random vertex.
+
+struct CliqueLocalSearch {
+    BitsetAdjacency adjacency;
+
+    std::vector<int> clique;
+    std::vector<char> isInClique;
+    // Number of members of C not adjacent to the vertex (a member counts itself)
+    std::vector<int> numMissingNeighbours;
+    // Iteration until which the vertex may not be swapped back into C
+    std::vector<long long> tabuUntil;
+
+    long long iteration;
+    std::mt19937 random;
+};
+
+void localSearchAddVertex(CliqueLocalSearch& search, int vertex) {
+    // Time complexity: O(V)
+
+    search.clique.push_back(vertex);
+    search.isInClique[vertex] = 1;
+
+    const BitsetWord* row = search.adjacency[vertex];
+    for (int u = 0; u < search.adjacency.numVertices; u++) {
+        if (!bitsetContains(row, u)) {
+            search.numMissingNeighbours[u]++;
+        }
+    }
+}
+
+void localSearchRemoveVertex(CliqueLocalSearch& search, int vertex, int tabuTenure) {
+    // Time complexity: O(V)
+
+    auto position = std::find(search.clique.begin(), search.clique.end(), vertex);
+    *position = search.clique.back();
+    search.clique.pop_back();
+    search.isInClique[vertex] = 0;
+    search.tabuUntil[vertex] = search.iteration + tabuTenure;
+
+    const BitsetWord* row = search.adjacency[vertex];
+    for (int u = 0; u < search.adjacency.numVertices; u++) {
+        if (!bitsetContains(row, u)) {
+            search.numMissingNeighbours[u]--;
+        }
+    }
+}
+
+// Minimal multiplicity between the vertex and the members of C (INT_MAX for an empty C)
+template <typename Multigraph>
+int localSearchAlphaWithClique(const Multigraph& multigraph, const CliqueLocalSearch& search, int vertex) {
+    int alpha = INT_MAX;
+    for (int member : search.clique) {
+        if (member != vertex) {
+            alpha = std::min(alpha, edgeMultiplicity(multigraph, vertex, member));
+        }
+    }
+    return alpha;
+}
+
+template <typename Multigraph>
+CompleteMultigraph localSearchCliqueSize(const Multigraph& multigraph, const CliqueLocalSearch& search) {
+    int alpha = INT_MAX;
+    for (int member : search.clique) {
+        alpha = std::min(alpha, localSearchAlphaWithClique(multigraph, search, member));
+    }
+
+    return {
+        alpha,
+        (int)search.clique.size()
+    };
+}
+
+// onImprovement(best, elapsedMilliseconds) is called with every new best clique (the starting one included)
+template <typename Multigraph, typename ImprovementCallback>
+CliqueAlgorithmResult maximalCliqueLocalSearch(const Multigraph& multigraph, long long timeLimitMilliseconds, ImprovementCallback onImprovement) {
+    // Time complexity: O(V^2) for the setup, then O(V^2) per greedy seed and O(V * |C|) per iteration until the time limit
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMilliseconds = [&start]() -> long long {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    int numVertices = multigraph.size();
+
+    CliqueLocalSearch search;
+    search.adjacency = makeBitsetAdjacency(multigraph);
+    search.isInClique.assign(numVertices, 0);
+    search.numMissingNeighbours.assign(numVertices, 0);
+    search.tabuUntil.assign(numVertices, 0);
+    search.iteration = 0;
+    search.random.seed(numVertices);
+
+    // Nothing better than the best clique size bound with the largest multiplicity is possible
+    int cliqueSizeBound = maximalCliqueSizeUpperBound(multigraph);
+    int maxMultiplicity = 0;
+    for (int u = 0; u < numVertices; u++) {
+        for (int v = u + 1; v < numVertices; v++) {
+            maxMultiplicity = std::max(maxMultiplicity, edgeMultiplicity(multigraph, u, v));
+        }
+    }
+
+    // The seeds of maximalCliquePolynomialApproximation, until the time limit (the first one always runs)
+    CliqueAlgorithmResult best = {{0, 0}, {}};
+    for (int seed = 0; seed < numVertices; seed++) {
+        if (seed > 0 && elapsedMilliseconds() >= timeLimitMilliseconds) {
+            break;
+        }
+
+        CliqueAlgorithmResult seedResult = maximalCliqueForSingleVertexGreedy(multigraph, seed);
+        if (isBetterGreedyCliqueResult(seedResult.completeMultigraph, best.completeMultigraph)) {
+            best = std::move(seedResult);
+        }
+    }
+    std::vector<BitsetWord> selectionBuffer;
+    if (best.completeMultigraph.n >= 2 && isSetOfVerticesFormCompleteMultigraph(search.adjacency, best.selection, selectionBuffer)) {
+        for (int vertex : best.selection) {
+            localSearchAddVertex(search, vertex);
+        }
+        std::sort(best.selection.begin(), best.selection.end());
+        onImprovement((const CliqueAlgorithmResult&)best, elapsedMilliseconds());
+    } else {
+        best = {{0, 0}, {}};
+    }
+
+    if (cliqueSizeBound < 2) {
+        return best;
+    }
+
+    const long long restartAfter = 100LL * numVertices + 1000;
+    long long lastImprovement = 0;
+
+    std::vector<int> moveCandidates;
+
+    while (true) {
+        if (best.completeMultigraph.n >= cliqueSizeBound && best.completeMultigraph.alpha >= maxMultiplicity) {
+            break;
+        }
+        if ((search.iteration & 63) == 0 && elapsedMilliseconds() >= timeLimitMilliseconds) {
+            break;
+        }
+        search.iteration++;
+
+        if (search.iteration - lastImprovement > restartAfter) {
+            while (!search.clique.empty()) {
+                localSearchRemoveVertex(search, search.clique.back(), 0);
+            }
+            std::fill(search.tabuUntil.begin(), search.tabuUntil.end(), 0);
+            localSearchAddVertex(search, search.random() % numVertices);
+            lastImprovement = search.iteration;
+        }
+
+        int tabuTenure = 7 + search.random() % 10;
+
+        // 1. Add: keep alpha as high as possible, random among the equal ones
+        int bestAddAlpha = -1;
+        moveCandidates.clear();
+        for (int u = 0; u < numVertices; u++) {
+            if (search.isInClique[u] || search.numMissingNeighbours[u] != 0) {
+                continue;
+            }
+
+            int alpha = localSearchAlphaWithClique(multigraph, search, u);
+            if (alpha > bestAddAlpha) {
+                bestAddAlpha = alpha;
+                moveCandidates.clear();
+            }
+            if (alpha == bestAddAlpha) {
+                moveCandidates.push_back(u);
+            }
+        }
+
+        if (!moveCandidates.empty()) {
+            localSearchAddVertex(search, moveCandidates[search.random() % moveCandidates.size()]);
+        } else {
+            // 2. Swap: any non-tabu vertex missing exactly one member of C
+            moveCandidates.clear();
+            for (int u = 0; u < numVertices; u++) {
+                if (!search.isInClique[u] && search.numMissingNeighbours[u] == 1 && search.tabuUntil[u] <= search.iteration) {
+                    moveCandidates.push_back(u);
+                }
+            }
+
+            if (!moveCandidates.empty()) {
+                int vertexIn = moveCandidates[search.random() % moveCandidates.size()];
+                int vertexOut = -1;
+                for (int member : search.clique) {
+                    if (!bitsetContains(search.adjacency[vertexIn], member)) {
+                        vertexOut = member;
+                    }
+                }
+
+                localSearchRemoveVertex(search, vertexOut, tabuTenure);
+                localSearchAddVertex(search, vertexIn);
+            } else if (!search.clique.empty()) {
+                // 3. Drop the member with the weakest edges
+                int vertexOut = search.clique[0];
+                int vertexOutAlpha = INT_MAX;
+                for (int member : search.clique) {
+                    int alpha = localSearchAlphaWithClique(multigraph, search, member);
+                    if (alpha < vertexOutAlpha) {
+                        vertexOutAlpha = alpha;
+                        vertexOut = member;
+                    }
+                }
+
+                localSearchRemoveVertex(search, vertexOut, tabuTenure);
+            }
+        }
+
+        if ((int)search.clique.size() < std::max(2, best.completeMultigraph.n)) {
+            continue;
+        }
+
+        CompleteMultigraph current = localSearchCliqueSize(multigraph, search);
+        if (isBetterGreedyCliqueResult(current, best.completeMultigraph)) {
+            best.completeMultigraph = current;
+            best.selection = search.clique;
+            std::sort(best.selection.begin(), best.selection.end());
+            lastImprovement = search.iteration;
+
+            onImprovement((const CliqueAlgorithmResult&)best, elapsedMilliseconds());
+        }
+    }
+
+    return best;
+}
+
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueLocalSearch(const Multigraph& multigraph, long long timeLimitMilliseconds) {
+    return maximalCliqueLocalSearch(multigraph, timeLimitMilliseconds, [](const CliqueAlgorithmResult&, long long) {});
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_3_LOCAL_SEARCH_H
@@ -12,88 +12,69 @@
 
 #include "graph_utils.h"
 #include "graph_solution_3.h"
+#include "bitset_adjacency.h"
+#include "subset_enumeration.h"
+#include "clique_colouring_bounds.h"
 
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_3_OPTIMIZED_BRUTEFORCE_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_3_OPTIMIZED_BRUTEFORCE_H
 
 #include <algorithm> // For std::sort
 
-CliqueAlgorithmResult maximalCliqueBruteforceOptimized(const MultigraphAdjacencyMatrix& multigraph) {
-    // For every single selection of selection in size of 2 to |V|
-    // 1. check if it is a complete multigraph
-    // 2. if yes, return it
-    // 3. if no, continue
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueBruteforceOptimized(const Multigraph& multigraph) {
+    // For every size of selection from |V| down to 2
+    // 1. enumerate the selections of that size from the largest bitset down (subset_enumeration.h)
+    // 2. keep the complete multigraph with the largest alpha
+    // 3. if the size had a complete multigraph, stop, no smaller selection can be better
 
-    // Time complexity: O(2^|V|)
+    // Time complexity: O(2^|V| * |V|^2 / 64) in the worst case, only the sizes down to the maximal clique are visited
 
-    // Start with the largest possible bitset
     auto multigraphSize = size(multigraph);
+    BitsetAdjacency adjacency = makeBitsetAdjacency(multigraph);
 
-    int enumerateFrom = 0;
-    int enumerateTo = multigraphSize.numVertices - 1;
-
-    int totalElements = enumerateTo - enumerateFrom + 1;
+    int totalElements = multigraphSize.numVertices;
     int minimalSize = 2; // Minimal size of a complete multigraph
-    int currentCompleteGraphSize = 0; // Current size of the complete multigraph
+
+    // No selection larger than the colouring / degree bound can be complete (clique_colouring_bounds.h)
+    int maximalSize = maximalCliqueSizeUpperBound(multigraph);
 
     std::vector<int> largestCompleteMultigraphSelection = {};
     CompleteMultigraph largestCompleteMultigraph = {0, 0};
 
-    // Iterate over all possible bitsets starting from the largest one.
-    // Iterating from the largest one is important, because we want to find the largest complete multigraph
-    // It makes sense to start from the largest one, because it is more likely to be a complete multigraph
-    for (int bitset = (1 << totalElements) - 1; bitset > 0; --bitset) {
-        std::vector<int> currentSelection;
+    // Reused for every complete selection, so nothing is allocated per candidate
+    std::vector<int> currentSelection;
+    currentSelection.reserve(totalElements);
 
+    for (int subsetSize = maximalSize; subsetSize >= minimalSize; subsetSize--) {
         // In this case, a bitset is a selection of vertices
         // I.E.:
         // For a graph with 4 vertices, the bitset 0011 means that the vertices 0 and 1 are selected
         // For a graph with 4 vertices, the bitset 1010 means that the vertices 1 and 3 are selected
         // For a graph with 4 vertices, the bitset 1111 means that all vertices are selected
-
-        // Construct the current selection based on the bitset
-        for (int j = 0; j < totalElements; ++j) {
-            if (bitset & (1 << j)) {
-                currentSelection.push_back(enumerateFrom + j);
+        forEachSubsetOfSizeDescendingAnyWidth(totalElements, subsetSize, [&](const BitsetWord* bitset) {
+            // Check if the current selection is a complete multigraph
+            if (!isSelectionFormCompleteMultigraph(adjacency, bitset)) {
+                return true;
             }
-        }
 
-        // If selection is less than minimal size, skip it
-        if (currentSelection.size() < minimalSize) {
-            continue;
-        }
-
-        // If selection is less than the current complete graph size, skip it
-        if (currentSelection.size() < currentCompleteGraphSize) {
-            continue;
-        }
+            currentSelection.clear();
+            bitsetForEach(bitset, adjacency.wordsPerRow, [&currentSelection](int vertex) {
+                currentSelection.push_back(vertex);
+            });
 
-        // Check if the current selection is a complete multigraph
-        if(!isSetOfVerticesFormCompleteMultigraph(multigraph, currentSelection)) {
-            continue;
-        }
-
-//        std::cout << "Found complete multigraph: ";
-//        for (const auto vertex: currentSelection) {
-//            std::cout << vertex << " ";
-//        }
-//        std::cout << std::endl;
-
-        int alpha = minimalAmountOfConnectionsBetweenVerticesInCompleteMultigraph(multigraph, currentSelection);
-        int n = currentSelection.size();
+            int alpha = minimalAmountOfConnectionsBetweenVerticesInCompleteMultigraph(multigraph, currentSelection);
+            if (alpha > largestCompleteMultigraph.alpha) {
+                largestCompleteMultigraphSelection = currentSelection;
+                largestCompleteMultigraph = {alpha, subsetSize};
+            }
 
-//        std::cout << "This is a " << alpha << "K" << n << " graph" << std::endl;
-        if (n > largestCompleteMultigraph.n) {
-            largestCompleteMultigraphSelection = currentSelection;
-            largestCompleteMultigraph = {alpha, n};
-        }
+            return true;
+        });
 
-        if (n == largestCompleteMultigraph.n && alpha > largestCompleteMultigraph.alpha) {
-            largestCompleteMultigraphSelection = currentSelection;
-            largestCompleteMultigraph = {alpha, n};
+        if (largestCompleteMultigraph.n > 0) {
+            break;
         }
-
-        currentCompleteGraphSize = n;
     }
 
     return {
@@ -15,11 +15,14 @@
 
 #include "graph_utils.h"
 #include "graph_solution_3.h"
+#include "bitset_adjacency.h"
+#include "thread_pool.h"
 
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_3_POLYNOMIAL_APPROXIMATION_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_3_POLYNOMIAL_APPROXIMATION_H
 
-CliqueAlgorithmResult maximalCliqueForSingleVertexGreedy(const MultigraphAdjacencyMatrix& multigraph, int vertex) {
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueForSingleVertexGreedy(const Multigraph& multigraph, int vertex) {
     // Time complexity: O(V^2)
 
     int n = multigraph.size();
@@ -68,7 +71,14 @@ CliqueAlgorithmResult maximalCliqueForSingleVertexGreedy(const MultigraphAdjacen
     };
 }
 
-CliqueAlgorithmResult maximalCliquePolynomialApproximation(const MultigraphAdjacencyMatrix& multigraph) {
+// Order of the seeds loop: a result replaces the best one only if it has more vertices,
+// or as many vertices and a larger alpha, so on ties the earliest seed wins
+bool isBetterGreedyCliqueResult(const CompleteMultigraph& candidate, const CompleteMultigraph& best) {
+    return candidate.n > best.n || (candidate.n == best.n && candidate.alpha > best.alpha);
+}
+
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliquePolynomialApproximation(const Multigraph& multigraph) {
     // Time complexity: O(V^3)
 
     auto multigraphSize = size(multigraph);
@@ -76,29 +86,150 @@ CliqueAlgorithmResult maximalCliquePolynomialApproximation(const MultigraphAdjac
     // Find the largest clique for each vertex
     // and return the largest one
 
-    std::vector<int> largestCompleteMultigraphSelection = {};
-    CompleteMultigraph largestCompleteMultigraph = {0, 0};
+    CliqueAlgorithmResult largestResult = {{0, 0}, {}};
 
     for (int i = 0; i < multigraphSize.numVertices; i++) {
         CliqueAlgorithmResult currentResult = maximalCliqueForSingleVertexGreedy(multigraph, i);
 
-        CompleteMultigraph currentCompleteMultigraph = currentResult.completeMultigraph;
-        std::vector<int> currentSelection = currentResult.selection;
-
-        if (currentCompleteMultigraph.n > largestCompleteMultigraph.n) {
-            largestCompleteMultigraphSelection = currentSelection;
-            largestCompleteMultigraph = currentCompleteMultigraph;
-        }
-        if(currentCompleteMultigraph.n == largestCompleteMultigraph.n && currentCompleteMultigraph.alpha > largestCompleteMultigraph.alpha) {
-            largestCompleteMultigraphSelection = currentSelection;
-            largestCompleteMultigraph = currentCompleteMultigraph;
+        if (isBetterGreedyCliqueResult(currentResult.completeMultigraph, largestResult.completeMultigraph)) {
+            largestResult = std::move(currentResult);
         }
     }
 
+    return largestResult;
+}
+
+// Scratch memory of one greedy run, reused between the seeds of a thread
+struct GreedyCliqueScratch {
+    std::vector<BitsetWord> candidates;
+    std::vector<int> alphaWithClique;
+};
+
+// Greedy clique from a seed on a shrinking candidate set: the candidates are always the common neighbourhood
+// of the clique so far (a bitset), and the next vertex is the candidate with the most neighbours among
+// the other candidates, i.e. the one that keeps the most room for the following steps.
+// Ties go to the candidate with the largest minimal multiplicity towards the clique, then to the lowest index.
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueForSingleVertexGreedyByDegree(const Multigraph& multigraph, const BitsetAdjacency& adjacency, int vertex, GreedyCliqueScratch& scratch) {
+    // Time complexity: O(d * |N(vertex)| * V / 64), d = size of the found clique
+
+    int numWords = adjacency.wordsPerRow;
+    scratch.candidates.assign(adjacency[vertex], adjacency[vertex] + numWords);
+    scratch.alphaWithClique.resize(adjacency.numVertices);
+    BitsetWord* candidates = scratch.candidates.data();
+
+    std::vector<int> clique = {vertex};
+    bitsetForEach(candidates, numWords, [&](int candidate) {
+        scratch.alphaWithClique[candidate] = edgeMultiplicity(multigraph, vertex, candidate);
+    });
+
+    while (!bitsetIsEmpty(candidates, numWords)) {
+        int selected = -1;
+        int selectedDegree = -1;
+        bitsetForEach(candidates, numWords, [&](int candidate) {
+            int candidateDegree = bitsetCountIntersection(candidates, adjacency[candidate], numWords);
+            if (
+                candidateDegree > selectedDegree
+                || (candidateDegree == selectedDegree && scratch.alphaWithClique[candidate] > scratch.alphaWithClique[selected])
+            ) {
+                selected = candidate;
+                selectedDegree = candidateDegree;
+            }
+        });
+
+        clique.push_back(selected);
+        bitsetIntersect(candidates, candidates, adjacency[selected], numWords);
+        bitsetForEach(candidates, numWords, [&](int candidate) {
+            scratch.alphaWithClique[candidate] = std::min(
+                scratch.alphaWithClique[candidate],
+                edgeMultiplicity(multigraph, selected, candidate)
+            );
+        });
+    }
+
+    std::sort(clique.begin(), clique.end());
+
+    int alpha = minimalAmountOfConnectionsBetweenVerticesInCompleteMultigraph(multigraph, clique);
+    CompleteMultigraph completeMultigraph = {
+        alpha,
+        (int)clique.size()
+    };
+
     return {
-        largestCompleteMultigraph,
-        largestCompleteMultigraphSelection
+        completeMultigraph,
+        clique
+    };
+}
+
+// Best greedy clique over all the seeds, seedGreedy(vertex, scratch) runs the greedy from one seed.
+// With more than one thread the seeds are cut into contiguous chunks, every chunk keeps its own best result
+// (earliest seed on ties), and the chunks are reduced in seed order, so the tie-breaking is the same as in the sequential loop.
+template <typename SeedGreedy>
+CliqueAlgorithmResult bestGreedyCliqueOverSeeds(int numVertices, int threadCount, SeedGreedy seedGreedy) {
+    // Time complexity: O(V * T(seedGreedy) / threadCount)
+
+    // Several chunks per thread, so stealing can balance seeds with very different neighbourhoods
+    int numChunks = threadCount > 1 ? std::max(1, std::min(numVertices, 8 * threadCount)) : 1;
+    std::vector<CliqueAlgorithmResult> chunkResults(numChunks, CliqueAlgorithmResult{{0, 0}, {}});
+
+    auto runChunk = [numVertices, numChunks, &chunkResults, &seedGreedy](int chunk) {
+        int chunkBegin = (long long)numVertices * chunk / numChunks;
+        int chunkEnd = (long long)numVertices * (chunk + 1) / numChunks;
+
+        CliqueAlgorithmResult& chunkResult = chunkResults[chunk];
+        GreedyCliqueScratch scratch;
+
+        for (int i = chunkBegin; i < chunkEnd; i++) {
+            CliqueAlgorithmResult currentResult = seedGreedy(i, scratch);
+
+            if (isBetterGreedyCliqueResult(currentResult.completeMultigraph, chunkResult.completeMultigraph)) {
+                chunkResult = std::move(currentResult);
+            }
+        }
     };
+
+    if (numChunks == 1) {
+        runChunk(0);
+    } else {
+        WorkStealingThreadPool threadPool(threadCount);
+        for (int chunk = 0; chunk < numChunks; chunk++) {
+            threadPool.submit([&runChunk, chunk]() {
+                runChunk(chunk);
+            });
+        }
+        threadPool.wait();
+    }
+
+    CliqueAlgorithmResult largestResult = {{0, 0}, {}};
+    for (auto& chunkResult : chunkResults) {
+        if (isBetterGreedyCliqueResult(chunkResult.completeMultigraph, largestResult.completeMultigraph)) {
+            largestResult = std::move(chunkResult);
+        }
+    }
+
+    return largestResult;
+}
+
+// Same result as maximalCliquePolynomialApproximation with the seeds split between threads
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliquePolynomialApproximationParallel(const Multigraph& multigraph, int threadCount) {
+    // Time complexity: O(V^3 / threadCount)
+
+    return bestGreedyCliqueOverSeeds(multigraph.size(), threadCount, [&multigraph](int vertex, GreedyCliqueScratch&) {
+        return maximalCliqueForSingleVertexGreedy(multigraph, vertex);
+    });
+}
+
+// maximalCliquePolynomialApproximation with the degree-ordered greedy (maximalCliqueForSingleVertexGreedyByDegree)
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliquePolynomialApproximationByDegree(const Multigraph& multigraph, int threadCount = 1) {
+    // Time complexity: O(V * d * Δ * V / 64 / threadCount), Δ = maximal degree of the support graph
+
+    BitsetAdjacency adjacency = makeBitsetAdjacency(multigraph);
+
+    return bestGreedyCliqueOverSeeds(multigraph.size(), threadCount, [&multigraph, &adjacency](int vertex, GreedyCliqueScratch& scratch) {
+        return maximalCliqueForSingleVertexGreedyByDegree(multigraph, adjacency, vertex, scratch);
+    });
 }
 
 #endif //AAC_LABORATORIES_GRAPH_SOLUTION_3_POLYNOMIAL_APPROXIMATION_H
@@ -0,0 +1,175 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <climits>
+
+#include "graph_utils.h"
+#include "graph_solution_3.h"
+#include "graph_solution_3_bron_kerbosch.h"
+#include "bitset_adjacency.h"
+#include "clique_colouring_bounds.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_3_WEIGHTED_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_3_WEIGHTED_H
+
+// Exact maximal clique optimising (n, alpha) directly instead of computing alpha after the fact.
+// G_t is the thresholded support graph (u ~ v iff edgeMultiplicity(multigraph, u, v) >= t), its cliques are the complete
+// submultigraphs with alpha >= t. The thresholds t are the distinct multiplicities, taken from high to low:
+// 1. at every threshold only cliques larger than the best one so far are searched for
+// 2. if G_t has a clique of s > n vertices, none of them exists in the higher thresholds,
+//    so every s-clique of G_t has alpha exactly t and (s, t) is the best pair among cliques of s vertices
+// 3. the first threshold that reaches the clique number of the support graph gives the answer,
+//    so ties on n are decided without enumerating all the maximum cliques
+// Every threshold is a maximum clique branch and bound (Tomita's MCQ on bitsets):
+// the candidates are greedily coloured, and a vertex of colour c can add at most c vertices to the current clique.
+// Once the best clique reaches the colouring bound of the support graph no lower threshold can improve n, so the search stops.
+
+struct WeightedCliqueSearch {
+    BitsetAdjacency adjacency;
+
+    // Candidate set of every recursion depth, wordsPerRow words each
+    std::vector<BitsetWord> candidateSets;
+    std::vector<BitsetWord> uncolouredSets;
+    std::vector<BitsetWord> colourClassSets;
+    // Candidates of every depth in colouring order with their colours
+    std::vector<std::vector<int>> colouringOrders;
+    std::vector<std::vector<int>> colours;
+
+    std::vector<int> currentClique;
+    std::vector<int> largestClique;
+    // Size to beat, starts at 1 as a single vertex is not a complete multigraph
+    int largestCliqueSize;
+};
+
+void weightedCliqueHelper(WeightedCliqueSearch& search, int depth) {
+    int numWords = search.adjacency.wordsPerRow;
+    BitsetWord* candidates = &search.candidateSets[(size_t)depth * numWords];
+    BitsetWord* nextCandidates = &search.candidateSets[(size_t)(depth + 1) * numWords];
+
+    greedyColouring(
+        search.adjacency,
+        candidates,
+        &search.uncolouredSets[(size_t)depth * numWords],
+        &search.colourClassSets[(size_t)depth * numWords],
+        search.colouringOrders[depth],
+        search.colours[depth]
+    );
+    const std::vector<int>& order = search.colouringOrders[depth];
+    const std::vector<int>& colours = search.colours[depth];
+
+    // The last coloured vertices have the highest colours, branch on them first
+    for (int k = (int)order.size() - 1; k >= 0; k--) {
+        if ((int)search.currentClique.size() + colours[k] <= search.largestCliqueSize) {
+            return;
+        }
+
+        int vertex = order[k];
+        search.currentClique.push_back(vertex);
+        bitsetIntersect(nextCandidates, candidates, search.adjacency[vertex], numWords);
+
+        if (bitsetIsEmpty(nextCandidates, numWords)) {
+            if ((int)search.currentClique.size() > search.largestCliqueSize) {
+                search.largestClique = search.currentClique;
+                search.largestCliqueSize = search.currentClique.size();
+            }
+        } else {
+            weightedCliqueHelper(search, depth + 1);
+        }
+
+        search.currentClique.pop_back();
+        bitsetReset(candidates, vertex);
+    }
+}
+
+template <typename Multigraph>
+CliqueAlgorithmResult maximalCliqueWeighted(const Multigraph& multigraph) {
+    // Time complexity: O(T * 2^V) in the worst case, T = number of distinct multiplicities
+    // Space complexity: O(V^2)
+
+    int numVertices = multigraph.size();
+
+    // Vertices are renumbered so that the bitsets list the densest part of the graph first:
+    // reversed degeneracy ordering of the support graph, colouring in this order gives few colours
+    std::vector<std::vector<int>> neighbours(numVertices);
+    std::vector<int> thresholds;
+    for (int u = 0; u < numVertices; u++) {
+        for (int v = 0; v < numVertices; v++) {
+            if (u != v && edgeMultiplicity(multigraph, u, v) > 0) {
+                neighbours[u].push_back(v);
+                thresholds.push_back(edgeMultiplicity(multigraph, u, v));
+            }
+        }
+    }
+
+    std::vector<int> ordering = degeneracyOrdering(neighbours);
+    std::reverse(ordering.begin(), ordering.end());
+
+    std::sort(thresholds.begin(), thresholds.end(), std::greater<int>());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+
+    WeightedCliqueSearch search;
+    search.adjacency = {
+        numVertices,
+        bitsetNumWords(numVertices),
+        {}
+    };
+    int numWords = search.adjacency.wordsPerRow;
+    search.adjacency.rows.assign((size_t)numVertices * numWords, 0);
+    search.candidateSets.assign((size_t)(numVertices + 1) * numWords, 0);
+    search.uncolouredSets.assign((size_t)(numVertices + 1) * numWords, 0);
+    search.colourClassSets.assign((size_t)(numVertices + 1) * numWords, 0);
+    search.colouringOrders.resize(numVertices + 1);
+    search.colours.resize(numVertices + 1);
+
+    CompleteMultigraph largestCompleteMultigraph = {0, 0};
+    std::vector<int> largestCompleteMultigraphSelection = {};
+
+    search.largestCliqueSize = 1;
+    int cliqueSizeBound = maximalCliqueSizeUpperBound(multigraph);
+
+    for (int threshold : thresholds) {
+        if (search.largestCliqueSize >= cliqueSizeBound) {
+            break;
+        }
+
+        // Adjacency of G_threshold in the new numbering
+        for (int u = 0; u < numVertices; u++) {
+            BitsetWord* row = search.adjacency[u];
+            for (int v = 0; v < numVertices; v++) {
+                if (u != v && edgeMultiplicity(multigraph, ordering[u], ordering[v]) >= threshold) {
+                    bitsetSet(row, v);
+                }
+            }
+        }
+
+        BitsetWord* candidates = &search.candidateSets[0];
+        for (int k = 0; k < numWords; k++) {
+            candidates[k] = 0;
+        }
+        for (int u = 0; u < numVertices; u++) {
+            bitsetSet(candidates, u);
+        }
+
+        int previousSize = search.largestCliqueSize;
+        weightedCliqueHelper(search, 0);
+
+        if (search.largestCliqueSize > previousSize) {
+            largestCompleteMultigraph = {threshold, search.largestCliqueSize};
+            largestCompleteMultigraphSelection.clear();
+            for (int vertex : search.largestClique) {
+                largestCompleteMultigraphSelection.push_back(ordering[vertex]);
+            }
+        }
+    }
+
+    std::sort(largestCompleteMultigraphSelection.begin(), largestCompleteMultigraphSelection.end());
+
+    return {
+        largestCompleteMultigraph,
+        largestCompleteMultigraphSelection
+    };
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_3_WEIGHTED_H
@@ -17,11 +17,15 @@
 #include "graph_utils.h"
 #include "graph_solution_2.h"
 #include "graph_solution_3.h"
+#include "subset_enumeration.h"
+#include "simd_kernels.h"
+#include "canonical_labelling.h"
 
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_4_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_4_H
 
-MultigraphAdjacencyMatrix makeSubmultigraphFromSelection(const MultigraphAdjacencyMatrix& multigraph, const std::vector<int>& selection) {
+template <typename Multigraph>
+MultigraphAdjacencyMatrix makeSubmultigraphFromSelection(const Multigraph& multigraph, const std::vector<int>& selection) {
     int numVertices = selection.size();
     MultigraphAdjacencyMatrix submultigraph(numVertices, std::vector<int>(numVertices));
 
@@ -35,53 +39,40 @@ MultigraphAdjacencyMatrix makeSubmultigraphFromSelection(const MultigraphAdjacen
     return submultigraph;
 }
 
-std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraph(MultigraphAdjacencyMatrix multigraph1, MultigraphAdjacencyMatrix multigraph2) {
+template <typename Multigraph>
+std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraph(const Multigraph& multigraph1, const Multigraph& multigraph2) {
     auto size1 = size(multigraph1);
     auto size2 = size(multigraph2);
 
     int minNumVertices = std::min(size1.numVertices, size2.numVertices);
 
-    // For all possible selections of vertices from 2 to numVertices1
-    std::vector<std::vector<int>> vectorSelections1 = enumerateAllPossibleSelectionsFromNtoM(0, size1.numVertices - 1, 2);
-    // Group selections by size
-    std::vector<std::vector<std::vector<int>>> groupedSelections1(minNumVertices + 1);
-    for (auto& selection : vectorSelections1) {
-        groupedSelections1[selection.size()].push_back(selection);
-    }
-
-    // For all possible selections of vertices from 2 to numVertices2
-    std::vector<std::vector<int>> vectorSelections2 = enumerateAllPossibleSelectionsFromNtoM(0, size2.numVertices - 1, 2);
-    // Group selections by size
-    std::vector<std::vector<std::vector<int>>> groupedSelections2(minNumVertices + 1);
-    for (auto& selection : vectorSelections2) {
-        groupedSelections2[selection.size()].push_back(selection);
-    }
-
     MultigraphSize currentMaximalCommonSubmultigraphSize = {0, 0};
     std::pair<std::vector<int>, std::vector<int>> currentMaximalCommonSubmultigraph;
 
-    for(int i = minNumVertices; i >= 0; --i) {
+    // Selections of the same size from both multigraphs, from the largest size down to 2.
+    // They are streamed (subset_enumeration.h), so only the current pair of selections is kept in memory.
+    for(int i = minNumVertices; i >= 2; --i) {
         if (currentMaximalCommonSubmultigraphSize.numVertices > i) {
             break;
         }
 
-        std::vector<std::vector<int>> selections1 = groupedSelections1[i];
-        std::vector<std::vector<int>> selections2 = groupedSelections2[i];
+        forEachCombination(size1.numVertices, i, [&](const std::vector<int>& selection1) {
+            MultigraphAdjacencyMatrix submultigraph1 = makeSubmultigraphFromSelection(multigraph1, selection1);
+            // Self-loops do not count, the same isomorphism as GED == 0 (canonical_labelling.h)
+            std::vector<int> certificate1 = canonicalForm(submultigraph1, false).certificate;
 
-        for (auto& selection1 : selections1) {
-            for (auto& selection2 : selections2) {
-                MultigraphAdjacencyMatrix submultigraph1 = makeSubmultigraphFromSelection(multigraph1, selection1);
+            forEachCombination(size2.numVertices, i, [&](const std::vector<int>& selection2) {
                 MultigraphAdjacencyMatrix submultigraph2 = makeSubmultigraphFromSelection(multigraph2, selection2);
 
-                // If GED is 0, then the submultigraphs are isomorphic
-                if (graphEditDistance(submultigraph1, submultigraph2) == 0) {
+                // Equal canonical forms: the submultigraphs are isomorphic
+                if (canonicalForm(submultigraph2, false).certificate == certificate1) {
                    auto submultigraphSize = size(submultigraph1);
 
                    if (compareSize(submultigraphSize, currentMaximalCommonSubmultigraphSize) == 1) {
                        currentMaximalCommonSubmultigraphSize = submultigraphSize;
                        currentMaximalCommonSubmultigraph = {selection1, selection2};
                    }
-                   continue;
+                   return true;
                 }
 
                 // If GED is not 0 we can still look for the maximal common submultigraph where
@@ -125,38 +116,24 @@ std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraph(Multigr
 //                std::cout << std::endl;
 
 
-                MultigraphAdjacencyMatrix minimalSubmultigraph{submultigraph1.size(), std::vector<int>(submultigraph1.size())};
+                // Row i of the minimal submultigraph over j >= i, one SIMD kernel call per row (simd_kernels.h);
+                // a pair connected in only one of the submultigraphs means the minimal one does not cover all vertices
                 bool minimalSubmultigraphDoesNotCoverAllVertices = false;
                 int minimalSubmultigraphNumVertices = submultigraph1.size();
                 int minimalSubmultigraphNumEdges = 0;
 
-                for (int i = 0; i < minimalSubmultigraph.size(); i++) {
-                    for (int j = i; j < minimalSubmultigraph.size(); j++) {
-                        minimalSubmultigraph[i][j] = std::min(submultigraph1[i][j], submultigraph2[i][j]);
-                        minimalSubmultigraph[j][i] = std::min(submultigraph1[i][j], submultigraph2[i][j]);
-
-                        minimalSubmultigraphNumEdges += minimalSubmultigraph[i][j];
-                        if (
-                            minimalSubmultigraph[i][j] == 0
-                            && (submultigraph1[i][j] != 0 || submultigraph2[i][j] != 0)
-                        ) {
-                            minimalSubmultigraphDoesNotCoverAllVertices = true;
-                        }
-                    }
+                for (int i = 0; i < minimalSubmultigraphNumVertices; i++) {
+                    minimalSubmultigraphNumEdges += elementwiseMinimumSum(
+                        submultigraph1[i].data(),
+                        submultigraph2[i].data(),
+                        i,
+                        minimalSubmultigraphNumVertices,
+                        minimalSubmultigraphDoesNotCoverAllVertices
+                    );
                 }
 
-//                // out minimalSubmultigraph
-//                std::cout << "Minimal submultigraph: " << std::endl;
-//                for (auto& row : minimalSubmultigraph) {
-//                    for (auto& element : row) {
-//                        std::cout << element << " ";
-//                    }
-//                    std::cout << std::endl;
-//                }
-//                std::cout << std::endl;
-
                 if (minimalSubmultigraphDoesNotCoverAllVertices) {
-                    continue;
+                    return true;
                 }
 
                 MultigraphSize minimalDegreeSequenceMultigraphSize = {
@@ -168,8 +145,12 @@ std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraph(Multigr
                     currentMaximalCommonSubmultigraphSize = minimalDegreeSequenceMultigraphSize;
                     currentMaximalCommonSubmultigraph = {selection1, selection2};
                 }
-            }
-        }
+
+                return true;
+            });
+
+            return true;
+        });
     }
 
     return currentMaximalCommonSubmultigraph;
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "graph_utils.h"
+#include "graph_solution_3_bron_kerbosch.h"
+#include "graph_solution_3_local_search.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_4_ASSOCIATION_GRAPH_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_4_ASSOCIATION_GRAPH_H
+
+// Maximal common submultigraph as a maximal clique in the association graph (modular product) of the two multigraphs.
+// 1. its vertices are all pairs (u1, u2): self-loops never restrict the mapping, the same rule as
+//    maximalCommonSubmultigraphMcSplit (graph_solution_4_mcsplit.h). maximalCommonSubmultigraph (graph_solution_4.h)
+//    rejects a pair with a self-loop on one side only outside of isomorphic selections, so a clique can have more
+//    vertices than its result, never fewer.
+// 2. (u1, u2) ~ (v1, v2) iff u1 != v1, u2 != v2 and u1, v1 are connected iff u2, v2 are connected
+// so a clique is exactly a mapping between selections under which every pair of distinct vertices is connected in both
+// or in neither, and the largest clique is the mapping with the most vertices.
+// The product is never stored: it only keeps the list of pairs (at most V1 * V2) and answers multigraph[a][b] from
+// the two multigraphs, so any clique solver templated on the multigraph runs on it unchanged (they keep their own
+// bitset adjacency, one bit per pair of pairs). The product is a simple graph (every multiplicity is 1), so the clique
+// solvers maximise the vertex count only: unlike maximalCommonSubmultigraph, ties are not broken by the edges, which
+// are whatever the found mapping gives.
+
+template <typename Multigraph>
+class AssociationGraph {
+public:
+    // Row a of the adjacency matrix, computed on access
+    class Row {
+    public:
+        Row(const AssociationGraph& associationGraph, int a): associationGraph(associationGraph), a(a) {}
+
+        int operator[](int b) const {
+            return associationGraph.multiplicity(a, b);
+        }
+
+    private:
+        const AssociationGraph& associationGraph;
+        int a;
+    };
+
+    AssociationGraph(const Multigraph& multigraph1, const Multigraph& multigraph2): multigraph1(multigraph1), multigraph2(multigraph2) {
+        // Time complexity: O(V1 * V2)
+
+        int numVertices1 = multigraph1.size();
+        int numVertices2 = multigraph2.size();
+        for (int u1 = 0; u1 < numVertices1; u1++) {
+            for (int u2 = 0; u2 < numVertices2; u2++) {
+                pairs.push_back({u1, u2});
+            }
+        }
+    }
+
+    int size() const {
+        return pairs.size();
+    }
+
+    Row operator[](int a) const {
+        return Row(*this, a);
+    }
+
+    // The pair (u1, u2) the vertex a stands for, the pairs are sorted by u1, then by u2
+    const std::pair<int, int>& vertexPair(int a) const {
+        return pairs[a];
+    }
+
+    int multiplicity(int a, int b) const {
+        // Time complexity: O(1)
+
+        const std::pair<int, int>& pairA = pairs[a];
+        const std::pair<int, int>& pairB = pairs[b];
+        if (pairA.first == pairB.first || pairA.second == pairB.second) {
+            return 0;
+        }
+
+        bool isConnected1 = edgeMultiplicity(multigraph1, pairA.first, pairB.first) > 0;
+        bool isConnected2 = edgeMultiplicity(multigraph2, pairA.second, pairB.second) > 0;
+        return isConnected1 == isConnected2 ? 1 : 0;
+    }
+
+private:
+    const Multigraph& multigraph1;
+    const Multigraph& multigraph2;
+    std::vector<std::pair<int, int>> pairs;
+};
+
+// Selections of the two multigraphs a clique of the association graph maps onto each other,
+// selection2[k] is mapped onto selection1[k] and selection1 is sorted
+template <typename Multigraph>
+std::pair<std::vector<int>, std::vector<int>> associationGraphCliqueToSelections(const AssociationGraph<Multigraph>& associationGraph, const CliqueAlgorithmResult& clique) {
+    // Time complexity: O(n log n)
+
+    std::vector<int> vertices = clique.selection;
+    std::sort(vertices.begin(), vertices.end());
+
+    std::pair<std::vector<int>, std::vector<int>> selections;
+    for (int a : vertices) {
+        selections.first.push_back(associationGraph.vertexPair(a).first);
+        selections.second.push_back(associationGraph.vertexPair(a).second);
+    }
+
+    return selections;
+}
+
+// Exact by maximalCliqueBronKerbosch, or maximalCliqueLocalSearch for timeLimitMilliseconds when it is positive
+template <typename Multigraph>
+std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraphAssociationGraph(const Multigraph& multigraph1, const Multigraph& multigraph2, long long timeLimitMilliseconds = 0) {
+    // Time complexity: O(T(clique solver)) on P <= V1 * V2 vertices, exponential in P for the exact one
+    // Space complexity: O(P^2 / 64)
+
+    AssociationGraph<Multigraph> associationGraph(multigraph1, multigraph2);
+
+    CliqueAlgorithmResult clique = timeLimitMilliseconds > 0
+        ? maximalCliqueLocalSearch(associationGraph, timeLimitMilliseconds)
+        : maximalCliqueBronKerbosch(associationGraph);
+
+    // Common submultigraphs start at 2 vertices, like the cliques
+    if (clique.completeMultigraph.n < 2) {
+        return {{}, {}};
+    }
+
+    return associationGraphCliqueToSelections(associationGraph, clique);
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_4_ASSOCIATION_GRAPH_H
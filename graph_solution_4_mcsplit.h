@@ -0,0 +1,435 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+#include "graph_utils.h"
+
+#ifndef AAC_LABORATORIES_GRAPH_SOLUTION_4_MCSPLIT_H
+#define AAC_LABORATORIES_GRAPH_SOLUTION_4_MCSPLIT_H
+
+// Exact maximal common submultigraph by McSplit-style branch and bound.
+// Objective: a bijection between vertices of both multigraphs such that every mapped pair of distinct vertices is
+// connected in both or in neither, the common submultigraph takes the smaller multiplicity of every pair (self-loops
+// included), and the largest one wins by compareSize (vertices, then edges).
+// Self-loops never restrict the mapping here: a vertex with a self-loop can be mapped onto one without, the pair brings
+// no self-loop. maximalCommonSubmultigraph (graph_solution_4.h) is not consistent about them: it ignores self-loops
+// between selections isomorphic up to them, but rejects such a pair in the order preserving mapping it tries between
+// the other selections. Mappings that pair a self-loop with no self-loop are accepted here and rejected there (and by a
+// brute force over that rule), so this search never finds fewer vertices and can find more. On the same vertices and
+// without self-loops it never finds fewer edges either.
+// 1. the not mapped vertices are kept in label classes: a pair of vertex sets (left from the 1st multigraph, right
+//    from the 2nd one) with the same adjacency to every mapped vertex, only vertices of the same class can be mapped
+//    onto each other. Mapping v onto w splits every class by adjacency to v / to w, in place.
+// 2. at most sum over classes of min(|left|, |right|) more vertices can be mapped, which bounds the vertices.
+//    When that only ties the best mapping, every class has to map exactly min(|left|, |right|) pairs to tie it, and the
+//    edges are bounded too: a pair brings at most the smaller of its two sides' self-loops and multiplicities to the
+//    mapped vertices, plus half of the smaller of the multiplicities towards the future partners, where a vertex can only
+//    have min(|left|, |right|) of those in every class (its largest multiplicities there). Within a class the pairs are
+//    not known yet, but pairing both sides sorted in decreasing order is the largest the sum of minimums can be.
+// 3. the class with the fewest vertices on its larger side is branched on, its left vertex of the largest degree is mapped
+//    onto every right vertex in turn (largest degree first) and then left out
+// The search is exponential: random pairs of 20 vertices take under a second, 30 vertices take about 10 seconds at
+// density 0.1 and over a minute at 0.5, 40 vertices and more are out of reach. timeLimitMilliseconds stops it with the
+// best mapping so far.
+
+struct McSplitLabelClass {
+    int leftBegin;
+    int rightBegin;
+    int leftSize;
+    int rightSize;
+};
+
+struct McSplitSearch {
+    int numVertices1;
+    int numVertices2;
+    // Multiplicity matrices in the renumbered (decreasing degree) order, row by row, self-loops on the diagonal
+    std::vector<int> multigraph1;
+    std::vector<int> multigraph2;
+
+    // Vertex lists the label classes are ranges of
+    std::vector<int> left;
+    std::vector<int> right;
+    // Label classes of every recursion depth, reused so the search does not allocate once they have grown
+    std::vector<std::vector<McSplitLabelClass>> classesAtDepth;
+
+    std::vector<std::pair<int, int>> mapping;
+    int numEdges;
+    // Self-loops plus the multiplicities to the mapped vertices, for every vertex of each multigraph
+    std::vector<int> mappedMultiplicities1;
+    std::vector<int> mappedMultiplicities2;
+
+    std::vector<std::pair<int, int>> bestMapping;
+    MultigraphSize bestSize;
+
+    // Scratch of the edges bound
+    std::vector<int> futureMultiplicities1;
+    std::vector<int> futureMultiplicities2;
+    std::vector<int> multiplicities;
+    std::vector<int> sortedValues1;
+    std::vector<int> sortedValues2;
+
+    // Optional time limit, checked every few hundred nodes; the search stops with the best mapping so far
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+    bool isTimedOut;
+    long long numNodes;
+};
+
+struct McSplitResult {
+    // (selection1, selection2) with selection2[k] mapped onto selection1[k], both empty when no two vertices can be mapped
+    std::pair<std::vector<int>, std::vector<int>> selections;
+    // False when the time limit stopped the search
+    bool isExact;
+    long long numNodes;
+};
+
+// Vertices of the range connected to v first, returns how many
+int mcSplitPartition(std::vector<int>& vertices, int begin, int size, const int* adjacencyRow) {
+    auto middle = std::partition(vertices.begin() + begin, vertices.begin() + begin + size, [adjacencyRow](int u) {
+        return adjacencyRow[u] > 0;
+    });
+    return middle - (vertices.begin() + begin);
+}
+
+void mcSplitFilterClasses(McSplitSearch& search, const std::vector<McSplitLabelClass>& classes, int v, int w, std::vector<McSplitLabelClass>& nextClasses) {
+    // Time complexity: O(V)
+
+    const int* row1 = &search.multigraph1[(size_t)v * search.numVertices1];
+    const int* row2 = &search.multigraph2[(size_t)w * search.numVertices2];
+
+    nextClasses.clear();
+    for (const McSplitLabelClass& labelClass : classes) {
+        int leftConnected = mcSplitPartition(search.left, labelClass.leftBegin, labelClass.leftSize, row1);
+        int rightConnected = mcSplitPartition(search.right, labelClass.rightBegin, labelClass.rightSize, row2);
+
+        int leftNotConnected = labelClass.leftSize - leftConnected;
+        int rightNotConnected = labelClass.rightSize - rightConnected;
+        if (leftConnected > 0 && rightConnected > 0) {
+            nextClasses.push_back({labelClass.leftBegin, labelClass.rightBegin, leftConnected, rightConnected});
+        }
+        if (leftNotConnected > 0 && rightNotConnected > 0) {
+            nextClasses.push_back({labelClass.leftBegin + leftConnected, labelClass.rightBegin + rightConnected, leftNotConnected, rightNotConnected});
+        }
+    }
+}
+
+// futureMultiplicities[u] for every vertex of one side: the sum over classes of the largest multiplicities from u to
+// as many of their vertices on that side as the class can map (one less in the class of u)
+void mcSplitFutureMultiplicities(
+    McSplitSearch& search,
+    const std::vector<McSplitLabelClass>& classes,
+    const std::vector<int>& multigraph,
+    int numVertices,
+    const std::vector<int>& vertices,
+    bool isLeft,
+    std::vector<int>& futureMultiplicities
+) {
+    // Time complexity: O(V^2)
+
+    futureMultiplicities.resize(numVertices);
+    for (const McSplitLabelClass& labelClass : classes) {
+        int begin = isLeft ? labelClass.leftBegin : labelClass.rightBegin;
+        int size = isLeft ? labelClass.leftSize : labelClass.rightSize;
+
+        for (int k = begin; k < begin + size; k++) {
+            int u = vertices[k];
+            const int* row = &multigraph[(size_t)u * numVertices];
+            int total = 0;
+
+            for (const McSplitLabelClass& otherClass : classes) {
+                int otherBegin = isLeft ? otherClass.leftBegin : otherClass.rightBegin;
+                int otherSize = isLeft ? otherClass.leftSize : otherClass.rightSize;
+                int numPartners = std::min(otherClass.leftSize, otherClass.rightSize) - (&otherClass == &labelClass ? 1 : 0);
+                if (numPartners <= 0) {
+                    continue;
+                }
+                // Every vertex of the range can be a partner: nothing to select
+                if (numPartners >= otherSize - (&otherClass == &labelClass ? 1 : 0)) {
+                    for (int t = otherBegin; t < otherBegin + otherSize; t++) {
+                        total += row[vertices[t]];
+                    }
+                    if (&otherClass == &labelClass) {
+                        total -= row[u];
+                    }
+                    continue;
+                }
+
+                search.multiplicities.clear();
+                for (int t = otherBegin; t < otherBegin + otherSize; t++) {
+                    if (vertices[t] != u && row[vertices[t]] > 0) {
+                        search.multiplicities.push_back(row[vertices[t]]);
+                    }
+                }
+                if ((int)search.multiplicities.size() > numPartners) {
+                    std::nth_element(search.multiplicities.begin(), search.multiplicities.begin() + (numPartners - 1), search.multiplicities.end(), std::greater<int>());
+                    search.multiplicities.resize(numPartners);
+                }
+                for (int multiplicity : search.multiplicities) {
+                    total += multiplicity;
+                }
+            }
+
+            futureMultiplicities[u] = total;
+        }
+    }
+}
+
+// Sum of min(values1[i], values2[i]) over the count largest values of both, each sorted in decreasing order
+int mcSplitSortedMinimumSum(std::vector<int>& values1, std::vector<int>& values2, int count) {
+    std::partial_sort(values1.begin(), values1.begin() + count, values1.end(), std::greater<int>());
+    std::partial_sort(values2.begin(), values2.begin() + count, values2.end(), std::greater<int>());
+
+    int sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += std::min(values1[i], values2[i]);
+    }
+    return sum;
+}
+
+// Upper bound on the edges the rest of the mapping adds when every class maps min(|left|, |right|) pairs
+int mcSplitEdgesBound(McSplitSearch& search, const std::vector<McSplitLabelClass>& classes) {
+    // Time complexity: O(V^2)
+
+    mcSplitFutureMultiplicities(search, classes, search.multigraph1, search.numVertices1, search.left, true, search.futureMultiplicities1);
+    mcSplitFutureMultiplicities(search, classes, search.multigraph2, search.numVertices2, search.right, false, search.futureMultiplicities2);
+
+    int mappedBound = 0;
+    int doubledFutureBound = 0;
+    for (const McSplitLabelClass& labelClass : classes) {
+        int numPairs = std::min(labelClass.leftSize, labelClass.rightSize);
+
+        auto collect = [&search](std::vector<int>& values, const std::vector<int>& vertices, int begin, int size, const std::vector<int>& perVertex) {
+            values.clear();
+            for (int k = begin; k < begin + size; k++) {
+                values.push_back(perVertex[vertices[k]]);
+            }
+        };
+
+        collect(search.sortedValues1, search.left, labelClass.leftBegin, labelClass.leftSize, search.mappedMultiplicities1);
+        collect(search.sortedValues2, search.right, labelClass.rightBegin, labelClass.rightSize, search.mappedMultiplicities2);
+        mappedBound += mcSplitSortedMinimumSum(search.sortedValues1, search.sortedValues2, numPairs);
+
+        collect(search.sortedValues1, search.left, labelClass.leftBegin, labelClass.leftSize, search.futureMultiplicities1);
+        collect(search.sortedValues2, search.right, labelClass.rightBegin, labelClass.rightSize, search.futureMultiplicities2);
+        doubledFutureBound += mcSplitSortedMinimumSum(search.sortedValues1, search.sortedValues2, numPairs);
+    }
+
+    // Every edge between two future pairs is counted from both of them
+    return mappedBound + doubledFutureBound / 2;
+}
+
+// Maps v onto w (or back when sign is -1) in the multiplicities to the mapped vertices
+void mcSplitUpdateMappedMultiplicities(McSplitSearch& search, int v, int w, int sign) {
+    // Time complexity: O(V)
+
+    for (int u = 0; u < search.numVertices1; u++) {
+        search.mappedMultiplicities1[u] += sign * search.multigraph1[(size_t)u * search.numVertices1 + v];
+    }
+    for (int u = 0; u < search.numVertices2; u++) {
+        search.mappedMultiplicities2[u] += sign * search.multigraph2[(size_t)u * search.numVertices2 + w];
+    }
+}
+
+void mcSplitHelper(McSplitSearch& search, std::vector<McSplitLabelClass>& classes, int depth) {
+    if (search.isTimedOut) {
+        return;
+    }
+    search.numNodes++;
+    if (search.hasDeadline && (search.numNodes & 255) == 0 && std::chrono::steady_clock::now() >= search.deadline) {
+        search.isTimedOut = true;
+        return;
+    }
+
+    MultigraphSize currentSize = {(int)search.mapping.size(), search.numEdges};
+    if (compareSize(currentSize, search.bestSize) == 1) {
+        search.bestSize = currentSize;
+        search.bestMapping = search.mapping;
+    }
+
+    int vertexBound = search.mapping.size();
+    for (const McSplitLabelClass& labelClass : classes) {
+        vertexBound += std::min(labelClass.leftSize, labelClass.rightSize);
+    }
+    if (vertexBound < search.bestSize.numVertices) {
+        return;
+    }
+    // Only ties on the vertices: more edges are the only way to beat the best mapping
+    if (vertexBound == search.bestSize.numVertices && search.numEdges + mcSplitEdgesBound(search, classes) <= search.bestSize.numEdges) {
+        return;
+    }
+
+    if (classes.empty()) {
+        return;
+    }
+
+    // The class with the fewest vertices on its larger side, ties by the smallest vertex (the largest degree)
+    int classIndex = 0;
+    auto smallestLeftVertex = [&search](const McSplitLabelClass& labelClass) {
+        return *std::min_element(search.left.begin() + labelClass.leftBegin, search.left.begin() + labelClass.leftBegin + labelClass.leftSize);
+    };
+    for (int k = 1; k < (int)classes.size(); k++) {
+        int size = std::max(classes[k].leftSize, classes[k].rightSize);
+        int bestSize = std::max(classes[classIndex].leftSize, classes[classIndex].rightSize);
+        if (size < bestSize || (size == bestSize && smallestLeftVertex(classes[k]) < smallestLeftVertex(classes[classIndex]))) {
+            classIndex = k;
+        }
+    }
+
+    // v moves to the end of the left range and out of it
+    McSplitLabelClass& labelClass = classes[classIndex];
+    int v = smallestLeftVertex(labelClass);
+    auto vPosition = std::find(search.left.begin() + labelClass.leftBegin, search.left.begin() + labelClass.leftBegin + labelClass.leftSize, v);
+    std::iter_swap(vPosition, search.left.begin() + labelClass.leftBegin + labelClass.leftSize - 1);
+    labelClass.leftSize--;
+
+    // Right vertices in increasing order (decreasing degree), each one moved to the end of the range while it is tried
+    const int* row1 = &search.multigraph1[(size_t)v * search.numVertices1];
+    int rightBegin = labelClass.rightBegin;
+    int rightSize = labelClass.rightSize;
+    labelClass.rightSize--;
+
+    std::vector<McSplitLabelClass>& nextClasses = search.classesAtDepth[depth + 1];
+
+    int previousW = -1;
+    for (int tried = 0; tried < rightSize && !search.isTimedOut; tried++) {
+        int position = -1;
+        for (int k = rightBegin; k < rightBegin + rightSize; k++) {
+            if (search.right[k] > previousW && (position == -1 || search.right[k] < search.right[position])) {
+                position = k;
+            }
+        }
+        int w = search.right[position];
+        previousW = w;
+        std::swap(search.right[position], search.right[rightBegin + rightSize - 1]);
+
+        const int* row2 = &search.multigraph2[(size_t)w * search.numVertices2];
+        int addedEdges = std::min(row1[v], row2[w]);
+        for (auto& mappedPair : search.mapping) {
+            addedEdges += std::min(row1[mappedPair.first], row2[mappedPair.second]);
+        }
+
+        mcSplitFilterClasses(search, classes, v, w, nextClasses);
+
+        search.mapping.push_back({v, w});
+        search.numEdges += addedEdges;
+        mcSplitUpdateMappedMultiplicities(search, v, w, 1);
+        mcSplitHelper(search, nextClasses, depth + 1);
+        mcSplitUpdateMappedMultiplicities(search, v, w, -1);
+        search.numEdges -= addedEdges;
+        search.mapping.pop_back();
+    }
+
+    // v is left out: the class keeps its right side, it is dropped once the left side is empty
+    labelClass.rightSize = rightSize;
+    if (labelClass.leftSize == 0) {
+        classes.erase(classes.begin() + classIndex);
+    }
+    mcSplitHelper(search, classes, depth + 1);
+}
+
+// timeLimitMilliseconds <= 0 means no time limit
+template <typename Multigraph>
+McSplitResult maximalCommonSubmultigraphMcSplitWithTimeLimit(const Multigraph& multigraph1, const Multigraph& multigraph2, long long timeLimitMilliseconds) {
+    // Time complexity: O(V1^V2) in the worst case, O(V^2) per node, the bounds cut most of it
+    // Space complexity: O(V1^2 + V2^2 + V^2) for the classes along the recursion
+
+    int numVertices1 = multigraph1.size();
+    int numVertices2 = multigraph2.size();
+
+    // Both multigraphs renumbered by decreasing degree, so smaller numbers are branched on first
+    auto makeOrder = [](const Multigraph& multigraph) {
+        int numVertices = multigraph.size();
+        std::vector<int> degrees(numVertices, 0);
+        for (int u = 0; u < numVertices; u++) {
+            for (int w = 0; w < numVertices; w++) {
+                if (u != w && edgeMultiplicity(multigraph, u, w) > 0) {
+                    degrees[u]++;
+                }
+            }
+        }
+        std::vector<int> order(numVertices);
+        for (int u = 0; u < numVertices; u++) {
+            order[u] = u;
+        }
+        std::stable_sort(order.begin(), order.end(), [&degrees](int a, int b) {
+            return degrees[a] > degrees[b];
+        });
+        return order;
+    };
+    auto makeMatrix = [](const Multigraph& multigraph, const std::vector<int>& order) {
+        int numVertices = multigraph.size();
+        std::vector<int> matrix((size_t)numVertices * numVertices);
+        for (int a = 0; a < numVertices; a++) {
+            for (int b = 0; b < numVertices; b++) {
+                matrix[(size_t)a * numVertices + b] = a == b ? multigraph[order[a]][order[a]] : edgeMultiplicity(multigraph, order[a], order[b]);
+            }
+        }
+        return matrix;
+    };
+
+    std::vector<int> order1 = makeOrder(multigraph1);
+    std::vector<int> order2 = makeOrder(multigraph2);
+
+    McSplitSearch search;
+    search.numVertices1 = numVertices1;
+    search.numVertices2 = numVertices2;
+    search.multigraph1 = makeMatrix(multigraph1, order1);
+    search.multigraph2 = makeMatrix(multigraph2, order2);
+    search.numEdges = 0;
+    search.bestSize = {0, 0};
+    search.hasDeadline = timeLimitMilliseconds > 0;
+    if (search.hasDeadline) {
+        search.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMilliseconds);
+    }
+    search.isTimedOut = false;
+    search.numNodes = 0;
+
+    // Every call maps a vertex or leaves one out of the 1st multigraph
+    search.classesAtDepth.resize(numVertices1 + 2);
+
+    for (int u = 0; u < numVertices1; u++) {
+        search.left.push_back(u);
+        search.mappedMultiplicities1.push_back(search.multigraph1[(size_t)u * numVertices1 + u]);
+    }
+    for (int u = 0; u < numVertices2; u++) {
+        search.right.push_back(u);
+        search.mappedMultiplicities2.push_back(search.multigraph2[(size_t)u * numVertices2 + u]);
+    }
+
+    // Self-loops do not restrict the mapping: a single class of all vertices
+    std::vector<McSplitLabelClass>& initialClasses = search.classesAtDepth[0];
+    if (numVertices1 > 0 && numVertices2 > 0) {
+        initialClasses.push_back({0, 0, numVertices1, numVertices2});
+    }
+
+    mcSplitHelper(search, initialClasses, 0);
+
+    McSplitResult result = {{}, !search.isTimedOut, search.numNodes};
+
+    // maximalCommonSubmultigraph starts from selections of 2 vertices
+    if (search.bestSize.numVertices < 2) {
+        return result;
+    }
+
+    std::sort(search.bestMapping.begin(), search.bestMapping.end(), [&order1](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return order1[a.first] < order1[b.first];
+    });
+    for (auto& mappedPair : search.bestMapping) {
+        result.selections.first.push_back(order1[mappedPair.first]);
+        result.selections.second.push_back(order2[mappedPair.second]);
+    }
+
+    return result;
+}
+
+// Same selections as maximalCommonSubmultigraph: (selection1, selection2) with selection2[k] mapped onto selection1[k],
+// both empty when no two vertices can be mapped
+template <typename Multigraph>
+std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraphMcSplit(const Multigraph& multigraph1, const Multigraph& multigraph2) {
+    return maximalCommonSubmultigraphMcSplitWithTimeLimit(multigraph1, multigraph2, 0).selections;
+}
+
+#endif //AAC_LABORATORIES_GRAPH_SOLUTION_4_MCSPLIT_H
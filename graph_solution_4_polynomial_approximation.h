@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <random>
 #include <limits>
+#include <functional>
+#include <cstdlib>
 
 #include "graph_utils.h"
 #include "graph_solution_4.h"
@@ -20,8 +22,9 @@
 #ifndef AAC_LABORATORIES_GRAPH_SOLUTION_4_POLYNOMIAL_APPROXIMATION_H
 #define AAC_LABORATORIES_GRAPH_SOLUTION_4_POLYNOMIAL_APPROXIMATION_H
 
+template <typename Multigraph>
 MultigraphAdjacencyMatrix makeSubmultigraphFromSelection(
-    const MultigraphAdjacencyMatrix& multigraph,
+    const Multigraph& multigraph,
     const std::vector<int>& selectedVertices,
     int newVertex
 ) {
@@ -60,50 +63,148 @@ bool isSelected(
         && (find(selectedVertices2.begin(), selectedVertices2.end(), vertex2) != selectedVertices2.end());
 }
 
+// One side of the greedy search, kept up to date instead of rebuilding the submultigraphs for every candidate pair.
+// degrees are the degrees of makeSubmultigraphFromSelection(multigraph, selection): positions p < q of the selection
+// are joined by multigraph[selection[q]][selection[p]], so appending v adds multigraph[v][selection[p]] to every
+// degree, and v gets its self-loops and the sum of these.
+struct GreedyCommonSubmultigraphSide {
+    std::vector<int> selection;
+    // How many times the vertex is in the selection (a vertex already selected can be paired again)
+    std::vector<int> numSelected;
+    std::vector<int> degrees;
+
+    // Row v: the degree sequence (decreasing) of makeSubmultigraphFromSelection(multigraph, selection, v),
+    // candidateDegreesSize[v] values, rows are candidateDegreesStride apart
+    std::vector<int> candidateDegrees;
+    std::vector<int> candidateDegreesSize;
+    int candidateDegreesStride;
+};
+
+template <typename Multigraph>
+void greedyCommonSubmultigraphSideAppend(GreedyCommonSubmultigraphSide& side, const Multigraph& multigraph, int vertex) {
+    // Time complexity: O(k)
+
+    int newDegree = multigraph[vertex][vertex];
+    for (int p = 0; p < (int)side.selection.size(); p++) {
+        int multiplicity = multigraph[vertex][side.selection[p]];
+        side.degrees[p] += multiplicity;
+        newDegree += multiplicity;
+    }
+
+    side.selection.push_back(vertex);
+    side.degrees.push_back(newDegree);
+    side.numSelected[vertex]++;
+}
+
+template <typename Multigraph>
+void greedyCommonSubmultigraphSideUpdateCandidates(GreedyCommonSubmultigraphSide& side, const Multigraph& multigraph) {
+    // Time complexity: O(V * k log k)
+
+    int numVertices = multigraph.size();
+    int selectionSize = side.selection.size();
+    side.candidateDegreesStride = selectionSize + 1;
+    side.candidateDegrees.resize((size_t)numVertices * side.candidateDegreesStride);
+    side.candidateDegreesSize.resize(numVertices);
+
+    for (int v = 0; v < numVertices; v++) {
+        int* row = &side.candidateDegrees[(size_t)v * side.candidateDegreesStride];
+
+        if (side.numSelected[v] > 0) {
+            // makeSubmultigraphFromSelection does not add a vertex that is already selected
+            std::copy(side.degrees.begin(), side.degrees.end(), row);
+            side.candidateDegreesSize[v] = selectionSize;
+        } else {
+            int newDegree = multigraph[v][v];
+            for (int p = 0; p < selectionSize; p++) {
+                int multiplicity = multigraph[v][side.selection[p]];
+                row[p] = side.degrees[p] + multiplicity;
+                newDegree += multiplicity;
+            }
+            row[selectionSize] = newDegree;
+            side.candidateDegreesSize[v] = selectionSize + 1;
+        }
+
+        std::sort(row, row + side.candidateDegreesSize[v], std::greater<int>());
+    }
+}
+
+// graphEditDistancePolynomialApproximation of the two submultigraphs with i and j added, from their degree sequences
+int greedyCommonSubmultigraphPairGraphEditDistance(
+    const GreedyCommonSubmultigraphSide& side1,
+    const GreedyCommonSubmultigraphSide& side2,
+    int i,
+    int j
+) {
+    // Time complexity: O(k)
+
+    const int* degrees1 = &side1.candidateDegrees[(size_t)i * side1.candidateDegreesStride];
+    const int* degrees2 = &side2.candidateDegrees[(size_t)j * side2.candidateDegreesStride];
+    int numVertices1 = side1.candidateDegreesSize[i];
+    int numVertices2 = side2.candidateDegreesSize[j];
+
+    int editDistance = std::abs(numVertices1 - numVertices2);
+    int numCommon = std::min(numVertices1, numVertices2);
+    for (int t = 0; t < numCommon; t++) {
+        editDistance += std::abs(degrees1[t] - degrees2[t]);
+    }
+    for (int t = numCommon; t < numVertices1; t++) {
+        editDistance += degrees1[t];
+    }
+    for (int t = numCommon; t < numVertices2; t++) {
+        editDistance += degrees2[t];
+    }
+
+    return editDistance;
+}
+
+template <typename Multigraph>
 std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraphPolynomialApproximation(
-    const MultigraphAdjacencyMatrix& multigraph1,
-    const MultigraphAdjacencyMatrix& multigraph2,
+    const Multigraph& multigraph1,
+    const Multigraph& multigraph2,
     bool shouldIncludeStartVertices = false,
     int startVertex1 = 0,
     int startVertex2 = 0
 ) {
-    // Time complexity: O(V^3 * V^2)
+    // Time complexity: O(V * (V^2 * k + V * k log k)) = O(V^4)
     // Outer while loop: The outer loop continues until no improvements can be made. In the worst case, this can take O(V) iterations.
-
-    std::vector<int> selection1 = shouldIncludeStartVertices ? std::vector<int>{startVertex1} : std::vector<int>();
-    std::vector<int> selection2 = shouldIncludeStartVertices ? std::vector<int>{startVertex2} : std::vector<int>();
+    // Every iteration sorts the degree sequences with each single vertex added (O(V * k log k) per side),
+    // then every pair of vertices costs O(k) instead of building and sorting both submultigraphs (O(k^2))
+
+    GreedyCommonSubmultigraphSide side1;
+    GreedyCommonSubmultigraphSide side2;
+    side1.numSelected.assign(multigraph1.size(), 0);
+    side2.numSelected.assign(multigraph2.size(), 0);
+    if (shouldIncludeStartVertices) {
+        greedyCommonSubmultigraphSideAppend(side1, multigraph1, startVertex1);
+        greedyCommonSubmultigraphSideAppend(side2, multigraph2, startVertex2);
+    }
 
     int minimalCurrentGraphEditDistance = std::numeric_limits<int>::max();
     bool graphEditDistanceHasImproved = true;
 
     // Loop until no improvement is made
     while (graphEditDistanceHasImproved) {
-//        std::cout << "iter\n";
-
         graphEditDistanceHasImproved = false;
-        int maxVertexCount = selection1.size();
+        int maxVertexCount = side1.selection.size();
         std::pair<int, int> bestVertexPair = {-1, -1};
         int bestVertexPairGraphEditDistance = minimalCurrentGraphEditDistance;
 
+        greedyCommonSubmultigraphSideUpdateCandidates(side1, multigraph1);
+        greedyCommonSubmultigraphSideUpdateCandidates(side2, multigraph2);
+
         // Iterate through all pairs of vertices (one from each graph)
         for(int i = 0; i < multigraph1.size(); ++i) {
             for(int j = 0; j < multigraph2.size(); ++j) {
                 // Skip if the vertex pair is already selected
-                if (isSelected(i, j, selection1, selection2)) continue;
-
-                // Create submultigraphs by including a new pair of vertices
-                auto newSubmultigraph1 = makeSubmultigraphFromSelection(multigraph1, selection1, i);
-                auto newSubmultigraph2 = makeSubmultigraphFromSelection(multigraph2, selection2, j);
-
-//                std::cout << newSubmultigraph1.size() << " " << newSubmultigraph2.size() << std::endl;
+                if (side1.numSelected[i] > 0 && side2.numSelected[j] > 0) continue;
 
-                // Calculate the approximated GED for the new submultigraphs
-                int currentVertexPairGraphEditDistance = graphEditDistancePolynomialApproximation(newSubmultigraph1, newSubmultigraph2);
+                // Calculate the approximated GED for the submultigraphs with the new pair of vertices
+                int currentVertexPairGraphEditDistance = greedyCommonSubmultigraphPairGraphEditDistance(side1, side2, i, j);
 
                 // Check if the current GED is better and update if necessary
                 if (
                     currentVertexPairGraphEditDistance < bestVertexPairGraphEditDistance
-                    || (currentVertexPairGraphEditDistance == bestVertexPairGraphEditDistance && newSubmultigraph1.size() > maxVertexCount)
+                    || (currentVertexPairGraphEditDistance == bestVertexPairGraphEditDistance && side1.candidateDegreesSize[i] > maxVertexCount)
                 ) {
                     bestVertexPairGraphEditDistance = currentVertexPairGraphEditDistance;
                     bestVertexPair = {i, j};
@@ -114,18 +215,19 @@ std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraphPolynomi
 
         // Update the selected vertices if an improvement was made
         if (graphEditDistanceHasImproved) {
-            selection1.push_back(bestVertexPair.first);
-            selection2.push_back(bestVertexPair.second);
+            greedyCommonSubmultigraphSideAppend(side1, multigraph1, bestVertexPair.first);
+            greedyCommonSubmultigraphSideAppend(side2, multigraph2, bestVertexPair.second);
             minimalCurrentGraphEditDistance = bestVertexPairGraphEditDistance;
         }
     }
 
-    return {selection1, selection2};
+    return {side1.selection, side2.selection};
 }
 
+template <typename Multigraph>
 std::pair<std::vector<int>, std::vector<int>> maximalCommonSubmultigraphPolynomialApproximationImprovedSearch(
-    const MultigraphAdjacencyMatrix& multigraph1,
-    const MultigraphAdjacencyMatrix& multigraph2
+    const Multigraph& multigraph1,
+    const Multigraph& multigraph2
 ) {
     // Time complexity: O(V^3 * V^2 * V^2)
 
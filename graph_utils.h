@@ -13,6 +13,8 @@
 #ifndef AAC_LABORATORIES_GRAPH_UTILS_H
 #define AAC_LABORATORIES_GRAPH_UTILS_H
 
+// The solvers are templates over the multigraph type: anything with size() and multigraph[i][j] works,
+// i.e. MultigraphAdjacencyMatrix and DenseMultigraph (see dense_multigraph.h).
 using MultigraphAdjacencyMatrix = std::vector<std::vector<int>>;
 
 struct MultigraphSize {
@@ -35,11 +37,14 @@ struct ReadGraphResult {
     MultigraphAdjacencyMatrix multigraph;
 };
 
-ReadGraphResult readGraph(std::ifstream& inputFile) {
+// shouldPrint echoes the multigraph, batch commands turn it off
+ReadGraphResult readGraph(std::ifstream& inputFile, bool shouldPrint = true) {
     // Read the number of vertices
     int numVertices;
     inputFile >> numVertices;
-    std::cout << "Number of vertices: " << numVertices << std::endl;
+    if (shouldPrint) {
+        std::cout << "Number of vertices: " << numVertices << std::endl;
+    }
 
     std::vector<std::vector<int>> adjacencyMatrix(numVertices, std::vector<int>(numVertices));
 
@@ -50,6 +55,13 @@ ReadGraphResult readGraph(std::ifstream& inputFile) {
         }
     }
 
+    if (!shouldPrint) {
+        return {
+            numVertices,
+            adjacencyMatrix
+        };
+    }
+
     // Print the adjacency matrix
     std::cout << "Adjacency matrix:" << std::endl;
     for (int i = 0; i < numVertices; ++i) {
@@ -65,9 +77,19 @@ ReadGraphResult readGraph(std::ifstream& inputFile) {
     };
 }
 
+// Multiplicity of the edge between u and v.
+// Only the upper triangle is read (as in size and isSetOfVerticesFormCompleteMultigraph on sorted selections),
+// so the solvers that call it see a non-symmetric adjacency matrix as its upper triangle. The others read rows or
+// either triangle (the graph edit distance evaluators, maximalCliqueForSingleVertexGreedy) and expect it symmetric.
+template <typename Multigraph>
+int edgeMultiplicity(const Multigraph& multigraph, int u, int v) {
+    return u < v ? multigraph[u][v] : multigraph[v][u];
+}
+
 // 	A size of a multigraph:
 //  it is a pair of (|V| x |E|) where number of vertices takes the advantage in comparison
-MultigraphSize size(MultigraphAdjacencyMatrix multigraph) {
+template <typename Multigraph>
+MultigraphSize size(const Multigraph& multigraph) {
     // Time complexity: O(V^2)
 
     int numVertices = multigraph.size();
@@ -85,6 +107,12 @@ MultigraphSize size(MultigraphAdjacencyMatrix multigraph) {
     };
 }
 
+// From C++17 on, argument-dependent lookup also finds std::size for a std::vector, and both templates would be
+// equally good: the exact non-template overload wins
+MultigraphSize size(const MultigraphAdjacencyMatrix& multigraph) {
+    return ::size<MultigraphAdjacencyMatrix>(multigraph);
+}
+
 // Compare two sizes of multigraphs
 // 1. compare number of vertices
 // 2. if equal, compare number of edges
@@ -115,7 +143,8 @@ int compareSize(MultigraphSize size1, MultigraphSize size2) {
 }
 
 
-std::vector<std::pair<int, int>> degreeSequence(const MultigraphAdjacencyMatrix &multigraph) {
+template <typename Multigraph>
+std::vector<std::pair<int, int>> degreeSequence(const Multigraph& multigraph) {
     // Time complexity: O(V^2)
     // Space complexity: O(V)
 
@@ -152,7 +181,7 @@ void writeGraph(std::ofstream& outputFile, const MultigraphAdjacencyMatrix& mult
 }
 
 
-std::vector<ReadGraphResult> readGraphFromFile(const std::string& filename) {
+std::vector<ReadGraphResult> readGraphFromFile(const std::string& filename, bool shouldPrint = true) {
     std::ifstream inputFile(filename);
     if (!inputFile.is_open()) {
         std::cout << "Error: cannot open file " << filename << std::endl;
@@ -165,7 +194,7 @@ std::vector<ReadGraphResult> readGraphFromFile(const std::string& filename) {
     std::vector<ReadGraphResult> readGraphResults(graphCount);
 
     for (int i = 0; i < graphCount; ++i) {
-        readGraphResults[i] = readGraph(inputFile);
+        readGraphResults[i] = readGraph(inputFile, shouldPrint);
         // Skip the empty line
         inputFile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
@@ -187,4 +216,19 @@ void writeGraphToFile(const std::string& filename, const MultigraphAdjacencyMatr
     outputFile.close();
 }
 
+void writeGraphsToFile(const std::string& filename, const std::vector<MultigraphAdjacencyMatrix>& multigraphs) {
+    std::ofstream outputFile(filename);
+    if (!outputFile.is_open()) {
+        std::cout << "Error: cannot open file " << filename << std::endl;
+        throw std::runtime_error("Cannot open file");
+    }
+
+    outputFile << multigraphs.size() << std::endl;
+    for (auto& multigraph : multigraphs) {
+        writeGraph(outputFile, multigraph);
+        outputFile << std::endl;
+    }
+    outputFile.close();
+}
+
 #endif //AAC_LABORATORIES_GRAPH_UTILS_H
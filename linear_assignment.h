@@ -0,0 +1,140 @@
+#include <vector>
+#include <limits>
+
+#ifndef AAC_LABORATORIES_LINEAR_ASSIGNMENT_H
+#define AAC_LABORATORIES_LINEAR_ASSIGNMENT_H
+
+// Minimal cost perfect matching in a square cost matrix
+// (Hungarian algorithm in the shortest augmenting path form with potentials, as in Jonker-Volgenant).
+// The workspace is reused between calls, so repeated solving (e.g. in every branch and bound node) does not allocate.
+//
+// After solving, rowPotentials / columnPotentials form an optimal dual solution:
+//   rowPotentials[i + 1] + columnPotentials[j + 1] <= cost[i][j]
+// and cost[i][j] - rowPotentials[i + 1] - columnPotentials[j + 1] (the reduced cost) is how much
+// an assignment forced to contain (i, j) costs at least on top of the optimum.
+struct LinearAssignment {
+    int n;
+    std::vector<long long> rowPotentials;
+    std::vector<long long> columnPotentials;
+    std::vector<int> columnMatch;
+    std::vector<int> way;
+    std::vector<long long> minimalSlack;
+    std::vector<char> isColumnUsed;
+
+    // rowAssignment[i] is the column assigned to the row i
+    std::vector<int> rowAssignment;
+};
+
+void resizeLinearAssignment(LinearAssignment& linearAssignment, int n) {
+    linearAssignment.n = n;
+    linearAssignment.rowPotentials.assign(n + 1, 0);
+    linearAssignment.columnPotentials.assign(n + 1, 0);
+    linearAssignment.columnMatch.assign(n + 1, 0);
+    linearAssignment.way.assign(n + 1, 0);
+    linearAssignment.minimalSlack.assign(n + 1, 0);
+    linearAssignment.isColumnUsed.assign(n + 1, 0);
+    linearAssignment.rowAssignment.assign(n, -1);
+}
+
+// cost[i * stride + j] is the cost of assigning the row i to the column j.
+// Returns the cost of the optimal assignment.
+long long solveLinearAssignment(LinearAssignment& linearAssignment, const long long* cost, int n, int stride) {
+    // Time complexity: O(n^3)
+    // Space complexity: O(n) on top of the cost matrix
+
+    // Nothing to assign, and a fresh workspace of 0 rows has no buffers to reset
+    if (n == 0) {
+        linearAssignment.n = 0;
+        linearAssignment.rowAssignment.clear();
+        return 0;
+    }
+
+    if ((int)linearAssignment.rowAssignment.size() != n) {
+        resizeLinearAssignment(linearAssignment, n);
+    }
+
+    const long long infinity = std::numeric_limits<long long>::max() / 4;
+
+    std::vector<long long>& rowPotentials = linearAssignment.rowPotentials;
+    std::vector<long long>& columnPotentials = linearAssignment.columnPotentials;
+    std::vector<int>& columnMatch = linearAssignment.columnMatch;
+    std::vector<int>& way = linearAssignment.way;
+    std::vector<long long>& minimalSlack = linearAssignment.minimalSlack;
+    std::vector<char>& isColumnUsed = linearAssignment.isColumnUsed;
+
+    for (int j = 0; j <= n; j++) {
+        rowPotentials[j] = 0;
+        columnPotentials[j] = 0;
+        columnMatch[j] = 0;
+        way[j] = 0;
+    }
+
+    // Rows and columns are 1-based here, column 0 is the virtual start of an augmenting path
+    for (int i = 1; i <= n; i++) {
+        columnMatch[0] = i;
+        int column0 = 0;
+
+        for (int j = 0; j <= n; j++) {
+            minimalSlack[j] = infinity;
+            isColumnUsed[j] = 0;
+        }
+
+        // Grow the shortest augmenting path (Dijkstra on reduced costs) until it reaches a free column
+        do {
+            isColumnUsed[column0] = 1;
+            int row0 = columnMatch[column0];
+            long long delta = infinity;
+            int column1 = 0;
+
+            const long long* costRow = cost + (long long)(row0 - 1) * stride;
+            for (int j = 1; j <= n; j++) {
+                if (isColumnUsed[j]) {
+                    continue;
+                }
+
+                long long reducedCost = costRow[j - 1] - rowPotentials[row0] - columnPotentials[j];
+                if (reducedCost < minimalSlack[j]) {
+                    minimalSlack[j] = reducedCost;
+                    way[j] = column0;
+                }
+                if (minimalSlack[j] < delta) {
+                    delta = minimalSlack[j];
+                    column1 = j;
+                }
+            }
+
+            for (int j = 0; j <= n; j++) {
+                if (isColumnUsed[j]) {
+                    rowPotentials[columnMatch[j]] += delta;
+                    columnPotentials[j] -= delta;
+                } else {
+                    minimalSlack[j] -= delta;
+                }
+            }
+
+            column0 = column1;
+        } while (columnMatch[column0] != 0);
+
+        // Flip the augmenting path
+        do {
+            int column1 = way[column0];
+            columnMatch[column0] = columnMatch[column1];
+            column0 = column1;
+        } while (column0 != 0);
+    }
+
+    long long totalCost = 0;
+    for (int j = 1; j <= n; j++) {
+        linearAssignment.rowAssignment[columnMatch[j] - 1] = j - 1;
+        totalCost += cost[(long long)(columnMatch[j] - 1) * stride + (j - 1)];
+    }
+
+    return totalCost;
+}
+
+// Reduced cost of (row, column) after solveLinearAssignment
+long long linearAssignmentReducedCost(const LinearAssignment& linearAssignment, const long long* cost, int stride, int row, int column) {
+    return cost[(long long)row * stride + column] - linearAssignment.rowPotentials[row + 1] - linearAssignment.columnPotentials[column + 1];
+}
+
+#endif //AAC_LABORATORIES_LINEAR_ASSIGNMENT_H
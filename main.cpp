@@ -5,6 +5,7 @@
 #include <string>
 #include <fstream>
 #include <set>
+#include <map>
 #include <vector>
 #include <utility>
 #include <chrono>
@@ -14,6 +15,7 @@
 #include "library/clipp.h"
 #include "library/termcolor.h"
 #include "graph_utils.h"
+#include "dense_multigraph.h"
 #include "graph_solution_2.h"
 #include "graph_solution_2_polynomial_approximation.h"
 #include "graph_solution_3.h"
@@ -21,6 +23,21 @@
 #include "graph_solution_3_polynomial_approximation.h"
 #include "graph_solution_4.h"
 #include "graph_solution_4_polynomial_approximation.h"
+#include "graph_solution_2_branch_and_bound.h"
+#include "graph_solution_3_bron_kerbosch.h"
+#include "graph_solution_3_weighted.h"
+#include "clique_colouring_bounds.h"
+#include "graph_solution_3_local_search.h"
+#include "graph_solution_2_assignment_approximation.h"
+#include "graph_solution_2_beam_search.h"
+#include "graph_solution_2_a_star.h"
+#include "graph_solution_2_within.h"
+#include "graph_solution_2_distance_matrix.h"
+#include "graph_solution_2_vp_tree.h"
+#include "canonical_labelling.h"
+#include "subgraph_isomorphism.h"
+#include "graph_solution_4_mcsplit.h"
+#include "graph_solution_4_association_graph.h"
 #include "multigraph_generator.h"
 
 // For Multigraphs:
@@ -73,7 +90,23 @@ enum class AlgorithmToRun {
     GraphEditDistancePolynomialApproximation,
     MaximalCommonSubmultigraph,
     MaximalCommonSubmultigraphPolynomialApproximation,
-    MaximalCommonSubmultigraphPolynomialApproximationImprovedSearch
+    MaximalCommonSubmultigraphPolynomialApproximationImprovedSearch,
+    GraphEditDistanceBranchAndBound,
+    MaximalCliqueBronKerbosch,
+    MaximalCliqueWeighted,
+    MaximalCliquePolynomialApproximationByDegree,
+    MaximalCliqueLocalSearch,
+    GraphEditDistanceAssignmentApproximation,
+    GraphEditDistanceBeamSearch,
+    GraphEditDistanceAStar,
+    GraphEditDistanceWithin,
+    GraphEditDistanceMatrix,
+    GraphEditDistanceIndexBuild,
+    GraphEditDistanceIndexQuery,
+    DeduplicateGraphs,
+    SubgraphIsomorphism,
+    MaximalCommonSubmultigraphMcSplit,
+    MaximalCommonSubmultigraphAssociationGraph
 };
 
 struct AlgorithmRunResult {
@@ -90,6 +123,22 @@ int main(int argc, char* argv[]) {
     int numEdges;
 
     std::string filename;
+    int threadCount = 1;
+    long long timeLimitMilliseconds = 1000;
+    int beamWidth = 32;
+    long long memoryLimitMegabytes = 256;
+    long long exactSearchTimeLimitMilliseconds = 0;
+    int gedThreshold = 0;
+    std::vector<std::string> filenames;
+    std::string gedMethodName = "exact";
+    std::string matrixFormatName = "csv";
+    std::string outputFilename;
+    int tileSize = 16;
+    std::string indexFilename;
+    int numNeighbours = 1;
+    int queryRadius = -1;
+    bool isExactMatch = false;
+    long long maxEmbeddings = 1;
 
     auto generateMultigraphRunner = [](const std::string& filenamePrefix, int graphCount, int numVertices, int numEdges) -> AlgorithmRunResult {
         auto start = std::chrono::high_resolution_clock::now();
@@ -176,7 +225,7 @@ int main(int argc, char* argv[]) {
         clipp::value("filename", filename)
     );
 
-    auto maximalCliquePolynomialApproximationRunner = [](const std::string& filename) -> AlgorithmRunResult {
+    auto maximalCliquePolynomialApproximationRunner = [](const std::string& filename, int threadCount) -> AlgorithmRunResult {
         auto readGraphResults = readGraphFromFile(filename);
 
         if(readGraphResults.empty()) {
@@ -193,10 +242,15 @@ int main(int argc, char* argv[]) {
         auto readGraphResult = readGraphResults[0];
 
         auto start = std::chrono::high_resolution_clock::now();
-        auto completeMultigraph = maximalCliquePolynomialApproximation(readGraphResult.multigraph);
+        auto completeMultigraph = threadCount > 1
+            ? maximalCliquePolynomialApproximationParallel(readGraphResult.multigraph, threadCount)
+            : maximalCliquePolynomialApproximation(readGraphResult.multigraph);
         auto end = std::chrono::high_resolution_clock::now();
 
         std::cout << "Maximal clique: " << termcolor::on_bright_white << termcolor::grey << completeMultigraph.completeMultigraph.alpha << "K" << completeMultigraph.completeMultigraph.n << termcolor::reset << std::endl;
+
+        // Certified gap: no complete multigraph has more vertices than the colouring bound
+        printCliqueOptimalityGap(readGraphResult.multigraph, completeMultigraph);
         renderSelectionOnMultigraph(readGraphResult.multigraph, completeMultigraph.selection);
         return {
             std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
@@ -205,10 +259,11 @@ int main(int argc, char* argv[]) {
 
     auto maximalCliquePolynomialApproximationCli = (
         clipp::command("maximal-clique-polynomial-approximation").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCliquePolynomialApproximation),
-        clipp::value("filename", filename)
+        clipp::value("filename", filename),
+        clipp::option("--threads") & clipp::value("thread count", threadCount).doc("Split the greedy seeds between N threads")
     );
 
-    auto graphEditDistanceRunner = [](const std::string& filename) -> AlgorithmRunResult {
+    auto graphEditDistanceRunner = [](const std::string& filename, int threadCount) -> AlgorithmRunResult {
         auto readGraphResults = readGraphFromFile(filename);
 
         if(readGraphResults.size() < 2) {
@@ -222,11 +277,20 @@ int main(int argc, char* argv[]) {
             std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
         }
 
+        if (threadCount <= 0) {
+            std::cout << "Error: thread count must be greater than 0" << std::endl;
+            return {
+                0
+            };
+        }
+
         auto readGraphResult1 = readGraphResults[0];
         auto readGraphResult2 = readGraphResults[1];
 
         auto start = std::chrono::high_resolution_clock::now();
-        int graphEditDistanceResult = graphEditDistance(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        int graphEditDistanceResult = threadCount > 1
+            ? graphEditDistanceParallel(readGraphResult1.multigraph, readGraphResult2.multigraph, threadCount)
+            : graphEditDistance(readGraphResult1.multigraph, readGraphResult2.multigraph);
         auto end = std::chrono::high_resolution_clock::now();
 
         std::cout << "Graph edit distance: " << termcolor::on_bright_white << termcolor::grey << graphEditDistanceResult << termcolor::reset << std::endl;
@@ -237,7 +301,8 @@ int main(int argc, char* argv[]) {
 
     auto graphEditDistanceCli = (
         clipp::command("graph-edit-distance").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistance),
-        clipp::value("filename", filename)
+        clipp::value("filename", filename),
+        clipp::option("--threads") & clipp::value("thread count", threadCount).doc("Split the permutations between N threads, N >= 1 (default 1)")
     );
 
     auto graphEditDistancePolynomialApproximationRunner = [](const std::string& filename) -> AlgorithmRunResult {
@@ -305,12 +370,750 @@ int main(int argc, char* argv[]) {
         };
     };
 
-    auto maximalCommonSubmultigraphCli = (
-        clipp::command("maximal-common-submultigraph").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraph),
-        clipp::value("filename", filename)
+    auto maximalCommonSubmultigraphCli = (
+        clipp::command("maximal-common-submultigraph").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraph),
+        clipp::value("filename", filename)
+    );
+
+    auto maximalCommonSubmultigraphPolynomialApproximationRunner = [](const std::string& filename) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto selections = maximalCommonSubmultigraphPolynomialApproximation(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal common submultigraph: " << std::endl;
+        std::cout << "Selection from Graph 1: " << std::endl;
+        renderSelectionOnMultigraph(readGraphResult1.multigraph, selections.first);
+        std::cout << std::endl;
+        std::cout << "Selection from Graph 2: " << std::endl;
+        renderSelectionOnMultigraph(readGraphResult2.multigraph, selections.second);
+        std::cout << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCommonSubmultigraphPolynomialApproximationCli = (
+        clipp::command("maximal-common-submultigraph-polynomial-approximation").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphPolynomialApproximation),
+        clipp::value("filename", filename)
+    );
+
+    auto maximalCommonSubmultigraphPolynomialApproximationImprovedSearchRunner = [](const std::string& filename) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto selections = maximalCommonSubmultigraphPolynomialApproximationImprovedSearch(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal common submultigraph: " << std::endl;
+        std::cout << "Selection from Graph 1: " << std::endl;
+        renderSelectionOnMultigraph(readGraphResult1.multigraph, selections.first);
+        std::cout << std::endl;
+        std::cout << "Selection from Graph 2: " << std::endl;
+        renderSelectionOnMultigraph(readGraphResult2.multigraph, selections.second);
+        std::cout << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCommonSubmultigraphPolynomialApproximationImprovedSearchCli = (
+        clipp::command("maximal-common-submultigraph-polynomial-approximation-improved-search").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphPolynomialApproximationImprovedSearch),
+        clipp::value("filename", filename)
+    );
+
+    auto graphEditDistanceBranchAndBoundRunner = [](const std::string& filename, long long timeLimitMilliseconds) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto branchAndBoundResult = graphEditDistanceBranchAndBoundWithTimeLimit(readGraphResult1.multigraph, readGraphResult2.multigraph, timeLimitMilliseconds);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Graph edit distance: " << termcolor::on_bright_white << termcolor::grey << branchAndBoundResult.graphEditDistance << termcolor::reset << std::endl;
+        if (!branchAndBoundResult.isExact) {
+            std::cout << "Time limit reached, the graph edit distance is an upper bound" << std::endl;
+        }
+        std::cout << "Search nodes: " << branchAndBoundResult.numNodes << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceBranchAndBoundCli = (
+        clipp::command("graph-edit-distance-branch-and-bound").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceBranchAndBound),
+        clipp::value("filename", filename),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", exactSearchTimeLimitMilliseconds).doc("Stop with the best mapping so far after this many milliseconds (default 0, no limit)")
+    );
+
+    auto maximalCliqueBronKerboschRunner = [](const std::string& filename) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.empty()) {
+            std::cout << "Error: file must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 1) {
+            std::cout << "Warning: file contains more than 1 graph, only the first graph will be used" << std::endl;
+        }
+
+        auto readGraphResult = readGraphResults[0];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto completeMultigraph = maximalCliqueBronKerbosch(readGraphResult.multigraph);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal clique: " << termcolor::on_bright_white << termcolor::grey << completeMultigraph.completeMultigraph.alpha << "K" << completeMultigraph.completeMultigraph.n << termcolor::reset << std::endl;
+        renderSelectionOnMultigraph(readGraphResult.multigraph, completeMultigraph.selection);
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCliqueBronKerboschCli = (
+        clipp::command("maximal-clique-bron-kerbosch").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCliqueBronKerbosch),
+        clipp::value("filename", filename)
+    );
+
+    auto maximalCliqueWeightedRunner = [](const std::string& filename) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.empty()) {
+            std::cout << "Error: file must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 1) {
+            std::cout << "Warning: file contains more than 1 graph, only the first graph will be used" << std::endl;
+        }
+
+        auto readGraphResult = readGraphResults[0];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto completeMultigraph = maximalCliqueWeighted(readGraphResult.multigraph);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal clique: " << termcolor::on_bright_white << termcolor::grey << completeMultigraph.completeMultigraph.alpha << "K" << completeMultigraph.completeMultigraph.n << termcolor::reset << std::endl;
+        renderSelectionOnMultigraph(readGraphResult.multigraph, completeMultigraph.selection);
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCliqueWeightedCli = (
+        clipp::command("maximal-clique-weighted").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCliqueWeighted),
+        clipp::value("filename", filename)
+    );
+
+    auto maximalCliquePolynomialApproximationByDegreeRunner = [](const std::string& filename, int threadCount) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.empty()) {
+            std::cout << "Error: file must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 1) {
+            std::cout << "Warning: file contains more than 1 graph, only the first graph will be used" << std::endl;
+        }
+
+        auto readGraphResult = readGraphResults[0];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto completeMultigraph = maximalCliquePolynomialApproximationByDegree(readGraphResult.multigraph, threadCount);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal clique: " << termcolor::on_bright_white << termcolor::grey << completeMultigraph.completeMultigraph.alpha << "K" << completeMultigraph.completeMultigraph.n << termcolor::reset << std::endl;
+
+        // Certified gap: no complete multigraph has more vertices than the colouring bound
+        printCliqueOptimalityGap(readGraphResult.multigraph, completeMultigraph);
+        renderSelectionOnMultigraph(readGraphResult.multigraph, completeMultigraph.selection);
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCliquePolynomialApproximationByDegreeCli = (
+        clipp::command("maximal-clique-polynomial-approximation-by-degree").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCliquePolynomialApproximationByDegree),
+        clipp::value("filename", filename),
+        clipp::option("--threads") & clipp::value("thread count", threadCount).doc("Split the greedy seeds between N threads")
+    );
+
+    auto maximalCliqueLocalSearchRunner = [](const std::string& filename, long long timeLimitMilliseconds) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.empty()) {
+            std::cout << "Error: file must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 1) {
+            std::cout << "Warning: file contains more than 1 graph, only the first graph will be used" << std::endl;
+        }
+
+        auto readGraphResult = readGraphResults[0];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto completeMultigraph = maximalCliqueLocalSearch(
+            readGraphResult.multigraph,
+            timeLimitMilliseconds,
+            [](const CliqueAlgorithmResult& best, long long elapsedMilliseconds) {
+                std::cout << "Best clique after " << elapsedMilliseconds << " ms: " << best.completeMultigraph.alpha << "K" << best.completeMultigraph.n << std::endl;
+            }
+        );
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Maximal clique: " << termcolor::on_bright_white << termcolor::grey << completeMultigraph.completeMultigraph.alpha << "K" << completeMultigraph.completeMultigraph.n << termcolor::reset << std::endl;
+        renderSelectionOnMultigraph(readGraphResult.multigraph, completeMultigraph.selection);
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto maximalCliqueLocalSearchCli = (
+        clipp::command("maximal-clique-local-search").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCliqueLocalSearch),
+        clipp::value("filename", filename),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", timeLimitMilliseconds).doc("Stop the search after this many milliseconds (default 1000)")
+    );
+
+    auto graphEditDistanceAssignmentApproximationRunner = [](const std::string& filename) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto approximation = graphEditDistanceAssignmentApproximation(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Graph edit distance: " << termcolor::on_bright_white << termcolor::grey << approximation.upperBound << termcolor::reset << std::endl;
+        std::cout << "Graph edit distance lower bound: " << approximation.lowerBound << " (gap: at most " << approximation.upperBound - approximation.lowerBound << ")" << std::endl;
+
+        // Padding vertices stand for the vertices deleted from Graph 1 or inserted into Graph 2
+        int numVertices1 = readGraphResult1.multigraph.size();
+        int numVertices2 = readGraphResult2.multigraph.size();
+        std::cout << "Mapping (Graph 1 vertex -> Graph 2 vertex): " << std::endl;
+        for (int i = 0; i < (int)approximation.permutation.size(); i++) {
+            int u = approximation.permutation[i];
+            if (u < numVertices1 && i < numVertices2) {
+                std::cout << u << " -> " << i << std::endl;
+            } else if (u < numVertices1) {
+                std::cout << u << " -> deleted" << std::endl;
+            } else if (i < numVertices2) {
+                std::cout << "inserted -> " << i << std::endl;
+            }
+        }
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceAssignmentApproximationCli = (
+        clipp::command("graph-edit-distance-assignment-approximation").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceAssignmentApproximation),
+        clipp::value("filename", filename)
+    );
+
+    auto graphEditDistanceBeamSearchRunner = [](const std::string& filename, int beamWidth) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        if (beamWidth <= 0) {
+            std::cout << "Error: beam width must be greater than 0" << std::endl;
+            return {
+                0
+            };
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        int graphEditDistanceResult = graphEditDistanceBeamSearch(readGraphResult1.multigraph, readGraphResult2.multigraph, beamWidth);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Graph edit distance: " << termcolor::on_bright_white << termcolor::grey << graphEditDistanceResult << termcolor::reset << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceBeamSearchCli = (
+        clipp::command("graph-edit-distance-beam-search").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceBeamSearch),
+        clipp::value("filename", filename),
+        clipp::option("--beam-width") & clipp::value("width", beamWidth).doc("Partial mappings kept on every level (default 32)")
+    );
+
+    auto graphEditDistanceAStarRunner = [](const std::string& filename, long long memoryLimitMegabytes, long long timeLimitMilliseconds) -> AlgorithmRunResult {
+        // The limit is converted to bytes
+        if (memoryLimitMegabytes <= 0 || memoryLimitMegabytes > (std::numeric_limits<long long>::max() >> 20)) {
+            std::cout << "Error: memory limit must be greater than 0 and fit into bytes" << std::endl;
+            return {
+                0
+            };
+        }
+
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto aStarResult = graphEditDistanceAStar(readGraphResult1.multigraph, readGraphResult2.multigraph, memoryLimitMegabytes << 20, timeLimitMilliseconds);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Graph edit distance: " << termcolor::on_bright_white << termcolor::grey << aStarResult.graphEditDistance << termcolor::reset << std::endl;
+        if (!aStarResult.isExact) {
+            std::cout << "Time limit reached, graph edit distance lower bound: " << aStarResult.lowerBound << std::endl;
+        }
+        if (aStarResult.hasReachedMemoryLimit) {
+            std::cout << "Memory limit reached, the search was finished by depth-first branch and bound" << std::endl;
+        }
+        std::cout << "Expanded nodes: " << aStarResult.numExpandedNodes << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceAStarCli = (
+        clipp::command("graph-edit-distance-a-star").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceAStar),
+        clipp::value("filename", filename),
+        clipp::option("--memory-limit-mb") & clipp::value("megabytes", memoryLimitMegabytes).doc("Memory for the search nodes before falling back to depth-first search (default 256)"),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", exactSearchTimeLimitMilliseconds).doc("Stop with the best mapping so far after this many milliseconds (default 0, no limit)")
+    );
+
+    auto graphEditDistanceWithinRunner = [](const std::string& filename, int threshold) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        // Every pair of graphs of the file is compared, every graph is summarised only once
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<GraphEditDistanceFilterSignature> signatures;
+        for (auto& readGraphResult : readGraphResults) {
+            signatures.push_back(makeGraphEditDistanceFilterSignature(readGraphResult.multigraph));
+        }
+
+        int numPairsWithin = 0;
+        int numPairs = 0;
+        for (int i = 0; i < (int)readGraphResults.size(); i++) {
+            for (int j = i + 1; j < (int)readGraphResults.size(); j++) {
+                auto withinResult = graphEditDistanceWithin(
+                    readGraphResults[i].multigraph,
+                    signatures[i],
+                    readGraphResults[j].multigraph,
+                    signatures[j],
+                    threshold
+                );
+
+                numPairs++;
+                if (withinResult.isWithin) {
+                    numPairsWithin++;
+                }
+                std::cout << "Graphs " << i + 1 << " and " << j + 1 << ": " << (withinResult.isWithin ? "within" : "not within")
+                    << " (decided by " << graphEditDistanceFilterStageName(withinResult.decidedBy) << ")" << std::endl;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Pairs with graph edit distance at most " << threshold << ": " << termcolor::on_bright_white << termcolor::grey << numPairsWithin << termcolor::reset << " of " << numPairs << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceWithinCli = (
+        clipp::command("ged-within").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceWithin),
+        clipp::value("filename", filename),
+        clipp::value("threshold", gedThreshold)
+    );
+
+    auto graphEditDistanceMatrixRunner = [](
+        const std::vector<std::string>& filenames,
+        const std::string& methodName,
+        const std::string& formatName,
+        const std::string& outputFilename,
+        int threadCount,
+        int tileSize,
+        int beamWidth,
+        long long timeLimitMilliseconds
+    ) -> AlgorithmRunResult {
+        GraphEditDistanceMethod method;
+        if (!parseGraphEditDistanceMethod(methodName, method)) {
+            std::cout << "Error: unknown method " << methodName << ", expected exact, assignment, beam or degree" << std::endl;
+            return {
+                0
+            };
+        }
+
+        GraphEditDistanceMatrixFormat format;
+        if (!parseGraphEditDistanceMatrixFormat(formatName, format)) {
+            std::cout << "Error: unknown format " << formatName << ", expected csv or binary" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (format == GraphEditDistanceMatrixFormat::Binary && outputFilename.empty()) {
+            std::cout << "Error: binary output needs an output file" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (beamWidth <= 0) {
+            std::cout << "Error: beam width must be greater than 0" << std::endl;
+            return {
+                0
+            };
+        }
+
+        // The graphs of all files, in the order of the files, not echoed so that the matrix can go to the standard output.
+        // Kept in the dense storage: one buffer per graph and 2 bytes per multiplicity instead of a vector per row of ints
+        std::vector<DenseMultigraph<std::uint16_t>> multigraphs;
+        for (auto& filename : filenames) {
+            for (auto& multigraph : readDenseMultigraphsFromFile<std::uint16_t>(filename)) {
+                multigraphs.push_back(std::move(multigraph));
+            }
+        }
+
+        if (multigraphs.empty()) {
+            std::cout << "Error: files must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        std::ofstream outputFile;
+        if (!outputFilename.empty()) {
+            outputFile.open(outputFilename, std::ios::binary);
+            if (!outputFile.is_open()) {
+                std::cout << "Error: cannot open file " << outputFilename << std::endl;
+                return {
+                    0
+                };
+            }
+        }
+        std::ostream& output = outputFilename.empty() ? std::cout : outputFile;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        writeGraphEditDistanceMatrixHeader(output, format, multigraphs.size());
+        graphEditDistanceMatrix<DenseMultigraph<std::uint16_t>>(
+            multigraphs,
+            makeGraphEditDistanceFunction<DenseMultigraph<std::uint16_t>>(method, beamWidth, timeLimitMilliseconds),
+            threadCount,
+            tileSize,
+            [&output, format](int, const std::vector<int>& row) {
+                writeGraphEditDistanceMatrixRow(output, format, row);
+            }
+        );
+        output.flush();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (!outputFilename.empty()) {
+            std::cout << "Graph edit distance matrix: " << termcolor::on_bright_white << termcolor::grey << multigraphs.size() << "x" << multigraphs.size() << termcolor::reset << " written to " << outputFilename << std::endl;
+        }
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceMatrixCli = (
+        clipp::command("ged-matrix").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceMatrix),
+        clipp::values("filenames", filenames),
+        clipp::option("--method") & clipp::value("method", gedMethodName).doc("exact, assignment, beam or degree (default exact)"),
+        clipp::option("--format") & clipp::value("format", matrixFormatName).doc("csv or binary (default csv)"),
+        clipp::option("--output") & clipp::value("output filename", outputFilename).doc("Write the matrix to this file instead of the standard output"),
+        clipp::option("--threads") & clipp::value("thread count", threadCount).doc("Split the tiles of the matrix between N threads"),
+        clipp::option("--tile-size") & clipp::value("graphs", tileSize).doc("Rows and columns of a tile (default 16)"),
+        clipp::option("--beam-width") & clipp::value("beam width", beamWidth).doc("Partial mappings kept per level by the beam method (default 32)"),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", exactSearchTimeLimitMilliseconds).doc("Per pair limit of the exact method, the pairs that reach it get an upper bound (default 0, no limit)")
+    );
+
+    auto graphEditDistanceIndexBuildRunner = [](
+        const std::string& indexFilename,
+        const std::vector<std::string>& filenames,
+        const std::string& methodName,
+        int beamWidth
+    ) -> AlgorithmRunResult {
+        GraphEditDistanceMethod method;
+        if (!parseGraphEditDistanceMethod(methodName, method)) {
+            std::cout << "Error: unknown method " << methodName << ", expected exact, assignment, beam or degree" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (beamWidth <= 0) {
+            std::cout << "Error: beam width must be greater than 0" << std::endl;
+            return {
+                0
+            };
+        }
+
+        std::vector<MultigraphAdjacencyMatrix> multigraphs;
+        for (auto& filename : filenames) {
+            for (auto& readGraphResult : readGraphFromFile(filename, false)) {
+                multigraphs.push_back(readGraphResult.multigraph);
+            }
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto tree = buildGraphEditDistanceVpTree(multigraphs, method, beamWidth);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        writeGraphEditDistanceVpTreeToFile(indexFilename, tree);
+
+        std::cout << "Indexed graphs: " << termcolor::on_bright_white << termcolor::grey << tree.multigraphs.size() << termcolor::reset << " written to " << indexFilename << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceIndexBuildCli = (
+        clipp::command("ged-index-build").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceIndexBuild),
+        clipp::value("index filename", indexFilename),
+        clipp::values("filenames", filenames),
+        clipp::option("--method") & clipp::value("method", gedMethodName).doc("exact, assignment, beam or degree (default exact, the only one that never misses a neighbour)"),
+        clipp::option("--beam-width") & clipp::value("beam width", beamWidth).doc("Partial mappings kept per level by the beam method (default 32)")
+    );
+
+    auto graphEditDistanceIndexQueryRunner = [](const std::string& indexFilename, const std::string& filename, int numNeighbours, int queryRadius) -> AlgorithmRunResult {
+        auto tree = readGraphEditDistanceVpTreeFromFile(indexFilename);
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.empty()) {
+            std::cout << "Error: file must contain at least 1 graph" << std::endl;
+            return {
+                0
+            };
+        }
+
+        // Every graph of the file is a query
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < (int)readGraphResults.size(); i++) {
+            auto queryResult = queryRadius >= 0
+                ? graphEditDistanceRangeQuery(tree, readGraphResults[i].multigraph, queryRadius)
+                : graphEditDistanceNearestNeighbours(tree, readGraphResults[i].multigraph, numNeighbours);
+
+            std::cout << "Query " << i + 1 << ":";
+            for (auto& neighbour : queryResult.neighbours) {
+                std::cout << " " << termcolor::on_bright_white << termcolor::grey << "graph " << neighbour.graph + 1 << " (distance " << neighbour.distance << ")" << termcolor::reset;
+            }
+            std::cout << std::endl;
+            std::cout << "Distance evaluations: " << queryResult.numDistanceEvaluations << " of " << tree.multigraphs.size() << std::endl;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto graphEditDistanceIndexQueryCli = (
+        clipp::command("ged-index-query").set(selectedAlgorithmToRun, AlgorithmToRun::GraphEditDistanceIndexQuery),
+        clipp::value("index filename", indexFilename),
+        clipp::value("query filename", filename),
+        clipp::option("--k") & clipp::value("neighbours", numNeighbours).doc("Number of nearest neighbours to find (default 1)"),
+        clipp::option("--radius") & clipp::value("distance", queryRadius).doc("Find every graph at most this far instead of the nearest ones")
+    );
+
+    auto deduplicateGraphsRunner = [](const std::vector<std::string>& filenames, const std::string& outputFilename) -> AlgorithmRunResult {
+        std::vector<MultigraphAdjacencyMatrix> multigraphs;
+        for (auto& filename : filenames) {
+            for (auto& readGraphResult : readGraphFromFile(filename, false)) {
+                multigraphs.push_back(readGraphResult.multigraph);
+            }
+        }
+
+        // Hash join on the canonical hash, the certificates are compared too in case two classes share a hash
+        auto start = std::chrono::high_resolution_clock::now();
+        std::map<CanonicalHash, std::vector<int>> representativesByHash;
+        std::vector<CanonicalForm> representativeForms(multigraphs.size());
+        std::vector<MultigraphAdjacencyMatrix> distinctMultigraphs;
+
+        for (int i = 0; i < (int)multigraphs.size(); i++) {
+            CanonicalForm form = canonicalForm(multigraphs[i]);
+            CanonicalHash hash = canonicalHash(form);
+            std::vector<int>& representatives = representativesByHash[hash];
+
+            int duplicateOf = -1;
+            for (int representative : representatives) {
+                if (representativeForms[representative].certificate == form.certificate) {
+                    duplicateOf = representative;
+                    break;
+                }
+            }
+
+            std::cout << "Graph " << i + 1 << ": " << canonicalHashString(hash);
+            if (duplicateOf != -1) {
+                std::cout << " (isomorphic to graph " << duplicateOf + 1 << ")";
+            } else {
+                representatives.push_back(i);
+                representativeForms[i] = std::move(form);
+                distinctMultigraphs.push_back(multigraphs[i]);
+            }
+            std::cout << std::endl;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (!outputFilename.empty()) {
+            writeGraphsToFile(outputFilename, distinctMultigraphs);
+        }
+
+        std::cout << "Distinct graphs: " << termcolor::on_bright_white << termcolor::grey << distinctMultigraphs.size() << termcolor::reset << " of " << multigraphs.size() << std::endl;
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto deduplicateGraphsCli = (
+        clipp::command("dedup").set(selectedAlgorithmToRun, AlgorithmToRun::DeduplicateGraphs),
+        clipp::values("filenames", filenames),
+        clipp::option("--output") & clipp::value("output filename", outputFilename).doc("Write one graph of every isomorphism class to this file")
+    );
+
+    auto subgraphIsomorphismRunner = [](const std::string& filename, bool isExactMatch, long long maxEmbeddings) -> AlgorithmRunResult {
+        auto readGraphResults = readGraphFromFile(filename);
+
+        if(readGraphResults.size() < 2) {
+            std::cout << "Error: file must contain at least 2 graphs" << std::endl;
+            return {
+                0
+            };
+        }
+
+        if (readGraphResults.size() > 2) {
+            std::cout << "Warning: file contains more than 2 graphs, only the first 2 graphs will be used" << std::endl;
+        }
+
+        // The 1st graph is the pattern, the 2nd one the target
+        auto readGraphResult1 = readGraphResults[0];
+        auto readGraphResult2 = readGraphResults[1];
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto subgraphIsomorphismResult = findSubgraphEmbeddings(
+            readGraphResult1.multigraph,
+            readGraphResult2.multigraph,
+            isExactMatch ? SubgraphMatchMode::Exact : SubgraphMatchMode::AtMost,
+            maxEmbeddings
+        );
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Embeddings: " << termcolor::on_bright_white << termcolor::grey << subgraphIsomorphismResult.numEmbeddings << termcolor::reset;
+        if (subgraphIsomorphismResult.hasReachedLimit) {
+            std::cout << " (stopped at the limit)";
+        }
+        std::cout << std::endl;
+
+        if (subgraphIsomorphismResult.numEmbeddings > 0) {
+            std::vector<int> selection = subgraphIsomorphismResult.mapping;
+            for (int u = 0; u < (int)selection.size(); u++) {
+                std::cout << u << " -> " << selection[u] << std::endl;
+            }
+            std::sort(selection.begin(), selection.end());
+            renderSelectionOnMultigraph(readGraphResult2.multigraph, selection);
+        }
+        return {
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        };
+    };
+
+    auto subgraphIsomorphismCli = (
+        clipp::command("subgraph-isomorphism").set(selectedAlgorithmToRun, AlgorithmToRun::SubgraphIsomorphism),
+        clipp::value("filename", filename),
+        clipp::option("--exact").set(isExactMatch).doc("Match the multiplicities of every pattern pair exactly (induced), instead of at most"),
+        clipp::option("--max-embeddings") & clipp::value("count", maxEmbeddings).doc("Stop after this many embeddings, 0 for all of them (default 1)")
     );
 
-    auto maximalCommonSubmultigraphPolynomialApproximationRunner = [](const std::string& filename) -> AlgorithmRunResult {
+    auto maximalCommonSubmultigraphMcSplitRunner = [](const std::string& filename, long long timeLimitMilliseconds) -> AlgorithmRunResult {
         auto readGraphResults = readGraphFromFile(filename);
 
         if(readGraphResults.size() < 2) {
@@ -328,27 +1131,32 @@ int main(int argc, char* argv[]) {
         auto readGraphResult2 = readGraphResults[1];
 
         auto start = std::chrono::high_resolution_clock::now();
-        auto selections = maximalCommonSubmultigraphPolynomialApproximation(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        auto mcSplitResult = maximalCommonSubmultigraphMcSplitWithTimeLimit(readGraphResult1.multigraph, readGraphResult2.multigraph, timeLimitMilliseconds);
         auto end = std::chrono::high_resolution_clock::now();
 
         std::cout << "Maximal common submultigraph: " << std::endl;
         std::cout << "Selection from Graph 1: " << std::endl;
-        renderSelectionOnMultigraph(readGraphResult1.multigraph, selections.first);
+        renderSelectionOnMultigraph(readGraphResult1.multigraph, mcSplitResult.selections.first);
         std::cout << std::endl;
         std::cout << "Selection from Graph 2: " << std::endl;
-        renderSelectionOnMultigraph(readGraphResult2.multigraph, selections.second);
+        renderSelectionOnMultigraph(readGraphResult2.multigraph, mcSplitResult.selections.second);
         std::cout << std::endl;
+        if (!mcSplitResult.isExact) {
+            std::cout << "Time limit reached, the common submultigraph may not be the largest one" << std::endl;
+        }
+        std::cout << "Search nodes: " << mcSplitResult.numNodes << std::endl;
         return {
             std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
         };
     };
 
-    auto maximalCommonSubmultigraphPolynomialApproximationCli = (
-        clipp::command("maximal-common-submultigraph-polynomial-approximation").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphPolynomialApproximation),
-        clipp::value("filename", filename)
+    auto maximalCommonSubmultigraphMcSplitCli = (
+        clipp::command("maximal-common-submultigraph-mcsplit").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphMcSplit),
+        clipp::value("filename", filename),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", exactSearchTimeLimitMilliseconds).doc("Stop with the best mapping so far after this many milliseconds (default 0, no limit)")
     );
 
-    auto maximalCommonSubmultigraphPolynomialApproximationImprovedSearchRunner = [](const std::string& filename) -> AlgorithmRunResult {
+    auto maximalCommonSubmultigraphAssociationGraphRunner = [](const std::string& filename, long long timeLimitMilliseconds) -> AlgorithmRunResult {
         auto readGraphResults = readGraphFromFile(filename);
 
         if(readGraphResults.size() < 2) {
@@ -366,7 +1174,7 @@ int main(int argc, char* argv[]) {
         auto readGraphResult2 = readGraphResults[1];
 
         auto start = std::chrono::high_resolution_clock::now();
-        auto selections = maximalCommonSubmultigraphPolynomialApproximationImprovedSearch(readGraphResult1.multigraph, readGraphResult2.multigraph);
+        auto selections = maximalCommonSubmultigraphAssociationGraph(readGraphResult1.multigraph, readGraphResult2.multigraph, timeLimitMilliseconds);
         auto end = std::chrono::high_resolution_clock::now();
 
         std::cout << "Maximal common submultigraph: " << std::endl;
@@ -381,9 +1189,10 @@ int main(int argc, char* argv[]) {
         };
     };
 
-    auto maximalCommonSubmultigraphPolynomialApproximationImprovedSearchCli = (
-        clipp::command("maximal-common-submultigraph-polynomial-approximation-improved-search").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphPolynomialApproximationImprovedSearch),
-        clipp::value("filename", filename)
+    auto maximalCommonSubmultigraphAssociationGraphCli = (
+        clipp::command("maximal-common-submultigraph-association-graph").set(selectedAlgorithmToRun, AlgorithmToRun::MaximalCommonSubmultigraphAssociationGraph),
+        clipp::value("filename", filename),
+        clipp::option("--time-limit-ms") & clipp::value("milliseconds", exactSearchTimeLimitMilliseconds).doc("Anytime clique search for this many milliseconds (default 0, exact search)")
     );
 
     auto cli = (
@@ -397,6 +1206,22 @@ int main(int argc, char* argv[]) {
             | maximalCommonSubmultigraphCli
             | maximalCommonSubmultigraphPolynomialApproximationCli
             | maximalCommonSubmultigraphPolynomialApproximationImprovedSearchCli
+            | graphEditDistanceBranchAndBoundCli
+            | maximalCliqueBronKerboschCli
+            | maximalCliqueWeightedCli
+            | maximalCliquePolynomialApproximationByDegreeCli
+            | maximalCliqueLocalSearchCli
+            | graphEditDistanceAssignmentApproximationCli
+            | graphEditDistanceBeamSearchCli
+            | graphEditDistanceAStarCli
+            | graphEditDistanceWithinCli
+            | graphEditDistanceMatrixCli
+            | graphEditDistanceIndexBuildCli
+            | graphEditDistanceIndexQueryCli
+            | deduplicateGraphsCli
+            | subgraphIsomorphismCli
+            | maximalCommonSubmultigraphMcSplitCli
+            | maximalCommonSubmultigraphAssociationGraphCli
         ),
         clipp::option("-t", "--time").set(shouldPrintTime).doc("Print time taken to run the algorithm in milliseconds")
     );
@@ -414,6 +1239,22 @@ int main(int argc, char* argv[]) {
         std::cout << "7. Maximal Common Submultigraph" << std::endl;
         std::cout << "8. Maximal Common Submultigraph Polynomial Approximation" << std::endl;
         std::cout << "9. Maximal Common Submultigraph Polynomial Approximation Improved Search" << std::endl;
+        std::cout << "10. Graph Edit Distance Branch And Bound" << std::endl;
+        std::cout << "11. Maximal Clique Bron-Kerbosch" << std::endl;
+        std::cout << "12. Maximal Clique Weighted" << std::endl;
+        std::cout << "13. Maximal Clique Polynomial Approximation By Degree" << std::endl;
+        std::cout << "14. Maximal Clique Local Search" << std::endl;
+        std::cout << "15. Graph Edit Distance Assignment Approximation" << std::endl;
+        std::cout << "16. Graph Edit Distance Beam Search" << std::endl;
+        std::cout << "17. Graph Edit Distance A*" << std::endl;
+        std::cout << "18. Graph Edit Distance Within Threshold" << std::endl;
+        std::cout << "19. Graph Edit Distance Matrix" << std::endl;
+        std::cout << "20. Graph Edit Distance Index Build" << std::endl;
+        std::cout << "21. Graph Edit Distance Index Query" << std::endl;
+        std::cout << "22. Deduplicate Isomorphic Graphs" << std::endl;
+        std::cout << "23. Subgraph Isomorphism" << std::endl;
+        std::cout << "24. Maximal Common Submultigraph McSplit" << std::endl;
+        std::cout << "25. Maximal Common Submultigraph Association Graph" << std::endl;
 
         std::cout << "Enter number: ";
         std::cin >> selectedAlgorithmToRunString;
@@ -490,6 +1331,14 @@ int main(int argc, char* argv[]) {
                     return 1;
                 }
 
+                std::cout << "Enter thread count: ";
+                std::cin >> threadCount;
+                std::cout << std::endl;
+                if (threadCount <= 0) {
+                    std::cout << "Thread count must be greater than 0" << std::endl;
+                    return 1;
+                }
+
                 break;
             case 5:
                 selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistance;
@@ -501,6 +1350,14 @@ int main(int argc, char* argv[]) {
                     return 1;
                 }
 
+                std::cout << "Enter thread count: ";
+                std::cin >> threadCount;
+                std::cout << std::endl;
+                if (threadCount <= 0) {
+                    std::cout << "Thread count must be greater than 0" << std::endl;
+                    return 1;
+                }
+
                 break;
             case 6:
                 selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistancePolynomialApproximation;
@@ -545,6 +1402,331 @@ int main(int argc, char* argv[]) {
                     return 1;
                 }
 
+                break;
+            case 10:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceBranchAndBound;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter time limit in milliseconds (0 for no limit): ";
+                std::cin >> exactSearchTimeLimitMilliseconds;
+                std::cout << std::endl;
+                if (exactSearchTimeLimitMilliseconds < 0) {
+                    std::cout << "Time limit cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 11:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCliqueBronKerbosch;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 12:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCliqueWeighted;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 13:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCliquePolynomialApproximationByDegree;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter thread count: ";
+                std::cin >> threadCount;
+                std::cout << std::endl;
+                if (threadCount <= 0) {
+                    std::cout << "Thread count must be greater than 0" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 14:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCliqueLocalSearch;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter time limit in milliseconds: ";
+                std::cin >> timeLimitMilliseconds;
+                std::cout << std::endl;
+                if (timeLimitMilliseconds < 0) {
+                    std::cout << "Time limit cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 15:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceAssignmentApproximation;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 16:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceBeamSearch;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter beam width: ";
+                std::cin >> beamWidth;
+                std::cout << std::endl;
+                if (beamWidth <= 0) {
+                    std::cout << "Beam width must be greater than 0" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 17:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceAStar;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter memory limit in megabytes: ";
+                std::cin >> memoryLimitMegabytes;
+                std::cout << std::endl;
+                if (memoryLimitMegabytes <= 0) {
+                    std::cout << "Memory limit must be greater than 0" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter time limit in milliseconds (0 for no limit): ";
+                std::cin >> exactSearchTimeLimitMilliseconds;
+                std::cout << std::endl;
+                if (exactSearchTimeLimitMilliseconds < 0) {
+                    std::cout << "Time limit cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 18:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceWithin;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter graph edit distance threshold: ";
+                std::cin >> gedThreshold;
+                std::cout << std::endl;
+                if (gedThreshold < 0) {
+                    std::cout << "Threshold cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 19:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceMatrix;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+                filenames = {filename};
+
+                std::cout << "Enter method (exact, assignment, beam or degree): ";
+                std::cin >> gedMethodName;
+                std::cout << std::endl;
+
+                std::cout << "Enter thread count: ";
+                std::cin >> threadCount;
+                std::cout << std::endl;
+                if (threadCount <= 0) {
+                    std::cout << "Thread count must be greater than 0" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter output filename: ";
+                std::cin >> outputFilename;
+                std::cout << std::endl;
+                if (outputFilename.empty()) {
+                    std::cout << "Output filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter format (csv or binary): ";
+                std::cin >> matrixFormatName;
+                std::cout << std::endl;
+
+                break;
+            case 20:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceIndexBuild;
+                std::cout << "Enter index filename: ";
+                std::cin >> indexFilename;
+                std::cout << std::endl;
+                if (indexFilename.empty()) {
+                    std::cout << "Index filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+                filenames = {filename};
+
+                std::cout << "Enter method (exact, assignment, beam or degree): ";
+                std::cin >> gedMethodName;
+                std::cout << std::endl;
+
+                break;
+            case 21:
+                selectedAlgorithmToRun = AlgorithmToRun::GraphEditDistanceIndexQuery;
+                std::cout << "Enter index filename: ";
+                std::cin >> indexFilename;
+                std::cout << std::endl;
+                if (indexFilename.empty()) {
+                    std::cout << "Index filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter number of nearest neighbours (0 for a range query): ";
+                std::cin >> numNeighbours;
+                std::cout << std::endl;
+                if (numNeighbours < 0) {
+                    std::cout << "Number of neighbours cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                if (numNeighbours == 0) {
+                    std::cout << "Enter maximal distance: ";
+                    std::cin >> queryRadius;
+                    std::cout << std::endl;
+                    if (queryRadius < 0) {
+                        std::cout << "Maximal distance cannot be negative" << std::endl;
+                        return 1;
+                    }
+                }
+
+                break;
+            case 22:
+                selectedAlgorithmToRun = AlgorithmToRun::DeduplicateGraphs;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+                filenames = {filename};
+
+                break;
+            case 23:
+                selectedAlgorithmToRun = AlgorithmToRun::SubgraphIsomorphism;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter maximal number of embeddings (0 for all): ";
+                std::cin >> maxEmbeddings;
+                std::cout << std::endl;
+                if (maxEmbeddings < 0) {
+                    std::cout << "Number of embeddings cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter 1 to match the multiplicities exactly, 0 for at most: ";
+                std::cin >> isExactMatch;
+                std::cout << std::endl;
+
+                break;
+            case 24:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCommonSubmultigraphMcSplit;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter time limit in milliseconds (0 for no limit): ";
+                std::cin >> exactSearchTimeLimitMilliseconds;
+                std::cout << std::endl;
+                if (exactSearchTimeLimitMilliseconds < 0) {
+                    std::cout << "Time limit cannot be negative" << std::endl;
+                    return 1;
+                }
+
+                break;
+            case 25:
+                selectedAlgorithmToRun = AlgorithmToRun::MaximalCommonSubmultigraphAssociationGraph;
+                std::cout << "Enter filename: ";
+                std::cin >> filename;
+                std::cout << std::endl;
+                if (filename.empty()) {
+                    std::cout << "Filename cannot be empty" << std::endl;
+                    return 1;
+                }
+
+                std::cout << "Enter time limit in milliseconds (0 for the exact search): ";
+                std::cin >> exactSearchTimeLimitMilliseconds;
+                std::cout << std::endl;
+                if (exactSearchTimeLimitMilliseconds < 0) {
+                    std::cout << "Time limit cannot be negative" << std::endl;
+                    return 1;
+                }
+
                 break;
             default:
                 std::cout << "Invalid selection" << std::endl;
@@ -567,10 +1749,10 @@ int main(int argc, char* argv[]) {
             algorithmRunResult = maximalCliqueBruteforceOptimizedRunner(filename);
             break;
         case AlgorithmToRun::MaximalCliquePolynomialApproximation:
-            algorithmRunResult = maximalCliquePolynomialApproximationRunner(filename);
+            algorithmRunResult = maximalCliquePolynomialApproximationRunner(filename, threadCount);
             break;
         case AlgorithmToRun::GraphEditDistance:
-            algorithmRunResult = graphEditDistanceRunner(filename);
+            algorithmRunResult = graphEditDistanceRunner(filename, threadCount);
             break;
         case AlgorithmToRun::GraphEditDistancePolynomialApproximation:
             algorithmRunResult = graphEditDistancePolynomialApproximationRunner(filename);
@@ -584,6 +1766,54 @@ int main(int argc, char* argv[]) {
         case AlgorithmToRun::MaximalCommonSubmultigraphPolynomialApproximationImprovedSearch:
             algorithmRunResult = maximalCommonSubmultigraphPolynomialApproximationImprovedSearchRunner(filename);
             break;
+        case AlgorithmToRun::GraphEditDistanceBranchAndBound:
+            algorithmRunResult = graphEditDistanceBranchAndBoundRunner(filename, exactSearchTimeLimitMilliseconds);
+            break;
+        case AlgorithmToRun::MaximalCliqueBronKerbosch:
+            algorithmRunResult = maximalCliqueBronKerboschRunner(filename);
+            break;
+        case AlgorithmToRun::MaximalCliqueWeighted:
+            algorithmRunResult = maximalCliqueWeightedRunner(filename);
+            break;
+        case AlgorithmToRun::MaximalCliquePolynomialApproximationByDegree:
+            algorithmRunResult = maximalCliquePolynomialApproximationByDegreeRunner(filename, threadCount);
+            break;
+        case AlgorithmToRun::MaximalCliqueLocalSearch:
+            algorithmRunResult = maximalCliqueLocalSearchRunner(filename, timeLimitMilliseconds);
+            break;
+        case AlgorithmToRun::GraphEditDistanceAssignmentApproximation:
+            algorithmRunResult = graphEditDistanceAssignmentApproximationRunner(filename);
+            break;
+        case AlgorithmToRun::GraphEditDistanceBeamSearch:
+            algorithmRunResult = graphEditDistanceBeamSearchRunner(filename, beamWidth);
+            break;
+        case AlgorithmToRun::GraphEditDistanceAStar:
+            algorithmRunResult = graphEditDistanceAStarRunner(filename, memoryLimitMegabytes, exactSearchTimeLimitMilliseconds);
+            break;
+        case AlgorithmToRun::GraphEditDistanceWithin:
+            algorithmRunResult = graphEditDistanceWithinRunner(filename, gedThreshold);
+            break;
+        case AlgorithmToRun::GraphEditDistanceMatrix:
+            algorithmRunResult = graphEditDistanceMatrixRunner(filenames, gedMethodName, matrixFormatName, outputFilename, threadCount, tileSize, beamWidth, exactSearchTimeLimitMilliseconds);
+            break;
+        case AlgorithmToRun::GraphEditDistanceIndexBuild:
+            algorithmRunResult = graphEditDistanceIndexBuildRunner(indexFilename, filenames, gedMethodName, beamWidth);
+            break;
+        case AlgorithmToRun::GraphEditDistanceIndexQuery:
+            algorithmRunResult = graphEditDistanceIndexQueryRunner(indexFilename, filename, numNeighbours, queryRadius);
+            break;
+        case AlgorithmToRun::DeduplicateGraphs:
+            algorithmRunResult = deduplicateGraphsRunner(filenames, outputFilename);
+            break;
+        case AlgorithmToRun::SubgraphIsomorphism:
+            algorithmRunResult = subgraphIsomorphismRunner(filename, isExactMatch, maxEmbeddings);
+            break;
+        case AlgorithmToRun::MaximalCommonSubmultigraphMcSplit:
+            algorithmRunResult = maximalCommonSubmultigraphMcSplitRunner(filename, exactSearchTimeLimitMilliseconds);
+            break;
+        case AlgorithmToRun::MaximalCommonSubmultigraphAssociationGraph:
+            algorithmRunResult = maximalCommonSubmultigraphAssociationGraphRunner(filename, exactSearchTimeLimitMilliseconds);
+            break;
     }
 
     if (shouldPrintTime) {
@@ -0,0 +1,315 @@
+#include <cstdlib>
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define AAC_LABORATORIES_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#ifndef AAC_LABORATORIES_SIMD_KERNELS_H
+#define AAC_LABORATORIES_SIMD_KERNELS_H
+
+// Row kernels of the exact graph edit distance and maximal common submultigraph evaluators:
+// 1. sum over j of |rowA[permutation[j]] - rowB[j]|  (one row of the edge cost under a vertex mapping)
+// 2. the same for the two pairs of rows touched by swapping two positions of the permutation, fused in one pass
+//    (the O(V) swap delta of the permutation enumeration and of the local improvement of a mapping)
+// 3. sum over j of min(rowA[j], rowB[j]), and whether some j has exactly one of the two cells at 0
+//    (one row of the minimal submultigraph of maximalCommonSubmultigraph)
+// Every kernel has a scalar, SSE4.2, AVX2 and AVX-512 version. The vector versions are compiled with per-function
+// target attributes, so the build needs no -m flags, and the best one the CPU supports is picked once at runtime.
+// Compilers other than GCC / Clang on x86 get the scalar versions only.
+
+enum class SimdLevel {
+    Scalar,
+    Sse42,
+    Avx2,
+    Avx512
+};
+
+SimdLevel detectSimdLevel() {
+#ifdef AAC_LABORATORIES_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SimdLevel::Sse42;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512:
+            return "AVX-512";
+        case SimdLevel::Avx2:
+            return "AVX2";
+        case SimdLevel::Sse42:
+            return "SSE4.2";
+        default:
+            return "scalar";
+    }
+}
+
+int permutedAbsoluteDifferenceSumScalar(const int* rowA, const int* permutation, const int* rowB, int begin, int end) {
+    int sum = 0;
+    for (int j = begin; j < end; j++) {
+        sum += std::abs(rowA[permutation[j]] - rowB[j]);
+    }
+    return sum;
+}
+
+int swapDeltaSumScalar(const int* firstRowA, const int* firstRowB, const int* permutation, const int* secondRowA, const int* secondRowB, int begin, int end) {
+    int sum = 0;
+    for (int j = begin; j < end; j++) {
+        int firstA = firstRowA[permutation[j]];
+        int firstB = firstRowB[permutation[j]];
+        sum += std::abs(firstB - secondRowA[j]) + std::abs(firstA - secondRowB[j])
+            - std::abs(firstA - secondRowA[j]) - std::abs(firstB - secondRowB[j]);
+    }
+    return sum;
+}
+
+int elementwiseMinimumSumScalar(const int* rowA, const int* rowB, int begin, int end, bool& hasSupportMismatch) {
+    int sum = 0;
+    for (int j = begin; j < end; j++) {
+        sum += std::min(rowA[j], rowB[j]);
+        if ((rowA[j] == 0) != (rowB[j] == 0)) {
+            hasSupportMismatch = true;
+        }
+    }
+    return sum;
+}
+
+#ifdef AAC_LABORATORIES_SIMD_X86
+
+__attribute__((target("sse4.2")))
+int horizontalSumSse42(__m128i vector) {
+    vector = _mm_add_epi32(vector, _mm_shuffle_epi32(vector, _MM_SHUFFLE(1, 0, 3, 2)));
+    vector = _mm_add_epi32(vector, _mm_shuffle_epi32(vector, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(vector);
+}
+
+// No gather before AVX2, the permuted row is loaded lane by lane
+__attribute__((target("sse4.2")))
+int permutedAbsoluteDifferenceSumSse42(const int* rowA, const int* permutation, const int* rowB, int begin, int end) {
+    __m128i sum = _mm_setzero_si128();
+    int j = begin;
+    for (; j + 4 <= end; j += 4) {
+        __m128i a = _mm_set_epi32(rowA[permutation[j + 3]], rowA[permutation[j + 2]], rowA[permutation[j + 1]], rowA[permutation[j]]);
+        __m128i b = _mm_loadu_si128((const __m128i*)(rowB + j));
+        sum = _mm_add_epi32(sum, _mm_abs_epi32(_mm_sub_epi32(a, b)));
+    }
+
+    return horizontalSumSse42(sum) + permutedAbsoluteDifferenceSumScalar(rowA, permutation, rowB, j, end);
+}
+
+__attribute__((target("sse4.2")))
+int swapDeltaSumSse42(const int* firstRowA, const int* firstRowB, const int* permutation, const int* secondRowA, const int* secondRowB, int begin, int end) {
+    __m128i sum = _mm_setzero_si128();
+    int j = begin;
+    for (; j + 4 <= end; j += 4) {
+        const int* indices = permutation + j;
+        __m128i firstA = _mm_set_epi32(firstRowA[indices[3]], firstRowA[indices[2]], firstRowA[indices[1]], firstRowA[indices[0]]);
+        __m128i firstB = _mm_set_epi32(firstRowB[indices[3]], firstRowB[indices[2]], firstRowB[indices[1]], firstRowB[indices[0]]);
+        __m128i secondA = _mm_loadu_si128((const __m128i*)(secondRowA + j));
+        __m128i secondB = _mm_loadu_si128((const __m128i*)(secondRowB + j));
+
+        __m128i swapped = _mm_add_epi32(_mm_abs_epi32(_mm_sub_epi32(firstB, secondA)), _mm_abs_epi32(_mm_sub_epi32(firstA, secondB)));
+        __m128i current = _mm_add_epi32(_mm_abs_epi32(_mm_sub_epi32(firstA, secondA)), _mm_abs_epi32(_mm_sub_epi32(firstB, secondB)));
+        sum = _mm_add_epi32(sum, _mm_sub_epi32(swapped, current));
+    }
+
+    return horizontalSumSse42(sum) + swapDeltaSumScalar(firstRowA, firstRowB, permutation, secondRowA, secondRowB, j, end);
+}
+
+__attribute__((target("sse4.2")))
+int elementwiseMinimumSumSse42(const int* rowA, const int* rowB, int begin, int end, bool& hasSupportMismatch) {
+    __m128i sum = _mm_setzero_si128();
+    __m128i mismatch = _mm_setzero_si128();
+    __m128i zero = _mm_setzero_si128();
+    int j = begin;
+    for (; j + 4 <= end; j += 4) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(rowA + j));
+        __m128i b = _mm_loadu_si128((const __m128i*)(rowB + j));
+        sum = _mm_add_epi32(sum, _mm_min_epi32(a, b));
+        mismatch = _mm_or_si128(mismatch, _mm_xor_si128(_mm_cmpeq_epi32(a, zero), _mm_cmpeq_epi32(b, zero)));
+    }
+
+    if (!_mm_testz_si128(mismatch, mismatch)) {
+        hasSupportMismatch = true;
+    }
+
+    return horizontalSumSse42(sum) + elementwiseMinimumSumScalar(rowA, rowB, j, end, hasSupportMismatch);
+}
+
+__attribute__((target("avx2")))
+int horizontalSumAvx2(__m256i vector) {
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(vector), _mm256_extracti128_si256(vector, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+
+__attribute__((target("avx2")))
+int permutedAbsoluteDifferenceSumAvx2(const int* rowA, const int* permutation, const int* rowB, int begin, int end) {
+    __m256i sum = _mm256_setzero_si256();
+    int j = begin;
+    for (; j + 8 <= end; j += 8) {
+        __m256i indices = _mm256_loadu_si256((const __m256i*)(permutation + j));
+        __m256i a = _mm256_i32gather_epi32(rowA, indices, 4);
+        __m256i b = _mm256_loadu_si256((const __m256i*)(rowB + j));
+        sum = _mm256_add_epi32(sum, _mm256_abs_epi32(_mm256_sub_epi32(a, b)));
+    }
+
+    return horizontalSumAvx2(sum) + permutedAbsoluteDifferenceSumScalar(rowA, permutation, rowB, j, end);
+}
+
+__attribute__((target("avx2")))
+int swapDeltaSumAvx2(const int* firstRowA, const int* firstRowB, const int* permutation, const int* secondRowA, const int* secondRowB, int begin, int end) {
+    __m256i sum = _mm256_setzero_si256();
+    int j = begin;
+    for (; j + 8 <= end; j += 8) {
+        __m256i indices = _mm256_loadu_si256((const __m256i*)(permutation + j));
+        __m256i firstA = _mm256_i32gather_epi32(firstRowA, indices, 4);
+        __m256i firstB = _mm256_i32gather_epi32(firstRowB, indices, 4);
+        __m256i secondA = _mm256_loadu_si256((const __m256i*)(secondRowA + j));
+        __m256i secondB = _mm256_loadu_si256((const __m256i*)(secondRowB + j));
+
+        __m256i swapped = _mm256_add_epi32(_mm256_abs_epi32(_mm256_sub_epi32(firstB, secondA)), _mm256_abs_epi32(_mm256_sub_epi32(firstA, secondB)));
+        __m256i current = _mm256_add_epi32(_mm256_abs_epi32(_mm256_sub_epi32(firstA, secondA)), _mm256_abs_epi32(_mm256_sub_epi32(firstB, secondB)));
+        sum = _mm256_add_epi32(sum, _mm256_sub_epi32(swapped, current));
+    }
+
+    return horizontalSumAvx2(sum) + swapDeltaSumScalar(firstRowA, firstRowB, permutation, secondRowA, secondRowB, j, end);
+}
+
+__attribute__((target("avx2")))
+int elementwiseMinimumSumAvx2(const int* rowA, const int* rowB, int begin, int end, bool& hasSupportMismatch) {
+    __m256i sum = _mm256_setzero_si256();
+    __m256i mismatch = _mm256_setzero_si256();
+    __m256i zero = _mm256_setzero_si256();
+    int j = begin;
+    for (; j + 8 <= end; j += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(rowA + j));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(rowB + j));
+        sum = _mm256_add_epi32(sum, _mm256_min_epi32(a, b));
+        mismatch = _mm256_or_si256(mismatch, _mm256_xor_si256(_mm256_cmpeq_epi32(a, zero), _mm256_cmpeq_epi32(b, zero)));
+    }
+
+    if (!_mm256_testz_si256(mismatch, mismatch)) {
+        hasSupportMismatch = true;
+    }
+
+    return horizontalSumAvx2(sum) + elementwiseMinimumSumScalar(rowA, rowB, j, end, hasSupportMismatch);
+}
+
+__attribute__((target("avx512f")))
+int permutedAbsoluteDifferenceSumAvx512(const int* rowA, const int* permutation, const int* rowB, int begin, int end) {
+    __m512i sum = _mm512_setzero_si512();
+    int j = begin;
+    for (; j + 16 <= end; j += 16) {
+        __m512i indices = _mm512_loadu_si512((const void*)(permutation + j));
+        __m512i a = _mm512_i32gather_epi32(indices, (const void*)rowA, 4);
+        __m512i b = _mm512_loadu_si512((const void*)(rowB + j));
+        sum = _mm512_add_epi32(sum, _mm512_abs_epi32(_mm512_sub_epi32(a, b)));
+    }
+
+    return _mm512_reduce_add_epi32(sum) + permutedAbsoluteDifferenceSumScalar(rowA, permutation, rowB, j, end);
+}
+
+__attribute__((target("avx512f")))
+int swapDeltaSumAvx512(const int* firstRowA, const int* firstRowB, const int* permutation, const int* secondRowA, const int* secondRowB, int begin, int end) {
+    __m512i sum = _mm512_setzero_si512();
+    int j = begin;
+    for (; j + 16 <= end; j += 16) {
+        __m512i indices = _mm512_loadu_si512((const void*)(permutation + j));
+        __m512i firstA = _mm512_i32gather_epi32(indices, (const void*)firstRowA, 4);
+        __m512i firstB = _mm512_i32gather_epi32(indices, (const void*)firstRowB, 4);
+        __m512i secondA = _mm512_loadu_si512((const void*)(secondRowA + j));
+        __m512i secondB = _mm512_loadu_si512((const void*)(secondRowB + j));
+
+        __m512i swapped = _mm512_add_epi32(_mm512_abs_epi32(_mm512_sub_epi32(firstB, secondA)), _mm512_abs_epi32(_mm512_sub_epi32(firstA, secondB)));
+        __m512i current = _mm512_add_epi32(_mm512_abs_epi32(_mm512_sub_epi32(firstA, secondA)), _mm512_abs_epi32(_mm512_sub_epi32(firstB, secondB)));
+        sum = _mm512_add_epi32(sum, _mm512_sub_epi32(swapped, current));
+    }
+
+    return _mm512_reduce_add_epi32(sum) + swapDeltaSumScalar(firstRowA, firstRowB, permutation, secondRowA, secondRowB, j, end);
+}
+
+__attribute__((target("avx512f")))
+int elementwiseMinimumSumAvx512(const int* rowA, const int* rowB, int begin, int end, bool& hasSupportMismatch) {
+    __m512i sum = _mm512_setzero_si512();
+    __m512i zero = _mm512_setzero_si512();
+    __mmask16 mismatch = 0;
+    int j = begin;
+    for (; j + 16 <= end; j += 16) {
+        __m512i a = _mm512_loadu_si512((const void*)(rowA + j));
+        __m512i b = _mm512_loadu_si512((const void*)(rowB + j));
+        sum = _mm512_add_epi32(sum, _mm512_min_epi32(a, b));
+        mismatch |= _mm512_cmpeq_epi32_mask(a, zero) ^ _mm512_cmpeq_epi32_mask(b, zero);
+    }
+
+    if (mismatch) {
+        hasSupportMismatch = true;
+    }
+
+    return _mm512_reduce_add_epi32(sum) + elementwiseMinimumSumScalar(rowA, rowB, j, end, hasSupportMismatch);
+}
+
+#endif
+
+using PermutedAbsoluteDifferenceSumKernel = int (*)(const int*, const int*, const int*, int, int);
+using SwapDeltaSumKernel = int (*)(const int*, const int*, const int*, const int*, const int*, int, int);
+using ElementwiseMinimumSumKernel = int (*)(const int*, const int*, int, int, bool&);
+
+struct SimdKernels {
+    SimdLevel level;
+    PermutedAbsoluteDifferenceSumKernel permutedAbsoluteDifferenceSum;
+    SwapDeltaSumKernel swapDeltaSum;
+    ElementwiseMinimumSumKernel elementwiseMinimumSum;
+};
+
+SimdKernels makeSimdKernels(SimdLevel level) {
+    switch (level) {
+#ifdef AAC_LABORATORIES_SIMD_X86
+        case SimdLevel::Avx512:
+            return {level, permutedAbsoluteDifferenceSumAvx512, swapDeltaSumAvx512, elementwiseMinimumSumAvx512};
+        case SimdLevel::Avx2:
+            return {level, permutedAbsoluteDifferenceSumAvx2, swapDeltaSumAvx2, elementwiseMinimumSumAvx2};
+        case SimdLevel::Sse42:
+            return {level, permutedAbsoluteDifferenceSumSse42, swapDeltaSumSse42, elementwiseMinimumSumSse42};
+#endif
+        default:
+            return {SimdLevel::Scalar, permutedAbsoluteDifferenceSumScalar, swapDeltaSumScalar, elementwiseMinimumSumScalar};
+    }
+}
+
+// Kernels of the running CPU, detected on the first call
+const SimdKernels& simdKernels() {
+    static const SimdKernels kernels = makeSimdKernels(detectSimdLevel());
+    return kernels;
+}
+
+// Sum over j in [begin, end) of |rowA[permutation[j]] - rowB[j]|
+int permutedAbsoluteDifferenceSum(const int* rowA, const int* permutation, const int* rowB, int begin, int end) {
+    return simdKernels().permutedAbsoluteDifferenceSum(rowA, permutation, rowB, begin, end);
+}
+
+// Sum over j in [begin, end) of |firstRowB[p(j)] - secondRowA[j]| + |firstRowA[p(j)] - secondRowB[j]|
+//                             - |firstRowA[p(j)] - secondRowA[j]| - |firstRowB[p(j)] - secondRowB[j]|, p = permutation
+int swapDeltaSum(const int* firstRowA, const int* firstRowB, const int* permutation, const int* secondRowA, const int* secondRowB, int begin, int end) {
+    return simdKernels().swapDeltaSum(firstRowA, firstRowB, permutation, secondRowA, secondRowB, begin, end);
+}
+
+// Sum over j in [begin, end) of min(rowA[j], rowB[j]),
+// hasSupportMismatch is set if some j has exactly one of rowA[j], rowB[j] equal to 0 (it is never reset)
+int elementwiseMinimumSum(const int* rowA, const int* rowB, int begin, int end, bool& hasSupportMismatch) {
+    return simdKernels().elementwiseMinimumSum(rowA, rowB, begin, end, hasSupportMismatch);
+}
+
+#endif //AAC_LABORATORIES_SIMD_KERNELS_H
@@ -0,0 +1,328 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "graph_utils.h"
+#include "bitset_adjacency.h"
+
+#ifndef AAC_LABORATORIES_SUBGRAPH_ISOMORPHISM_H
+#define AAC_LABORATORIES_SUBGRAPH_ISOMORPHISM_H
+
+// Embeddings of a pattern multigraph into a target multigraph (VF2++ style state-space search).
+// An embedding maps the pattern vertices one to one onto target vertices so that every pair u, w of the pattern has
+// 1. AtMost: multiplicity(u, w) <= multiplicity(image u, image w), self-loops included (the pattern is a submultigraph)
+// 2. Exact: multiplicity(u, w) == multiplicity(image u, image w), i.e. an induced submultigraph with the same multiplicities
+// Pairs are read with edgeMultiplicity (graph_utils.h), like the clique solvers do.
+// The search:
+// 1. every pattern vertex starts with a domain of target vertices whose self-loop, degree, neighbour count and
+//    largest multiplicity can hold it
+// 2. the pattern vertices are matched in the VF2++ order: breadth first from the vertex with the rarest domain,
+//    inside a level the most connected to the already ordered vertices first, then the rarest, then the largest degree
+// 3. the candidates of a vertex are its domain intersected with the target neighbourhoods of its mapped neighbours
+//    (and without the ones of its mapped non-neighbours in the Exact mode), word by word on bitsets (bitset_adjacency.h)
+// 4. a candidate also needs as many unused neighbours as the pattern vertex has neighbours not mapped yet
+
+enum class SubgraphMatchMode {
+    AtMost,
+    Exact
+};
+
+struct SubgraphIsomorphismSearch {
+    SubgraphMatchMode mode;
+    int numPatternVertices;
+    int numTargetVertices;
+    // Multiplicity matrices row by row, the diagonal holds the self-loops
+    std::vector<int> pattern;
+    std::vector<int> target;
+    BitsetAdjacency targetAdjacency;
+    int wordsPerRow;
+
+    // Pattern vertices in the order of matching
+    std::vector<int> order;
+    // Pattern neighbours / non-neighbours of order[k] among order[0..k - 1]
+    std::vector<std::vector<int>> earlierNeighbours;
+    std::vector<std::vector<int>> earlierNonNeighbours;
+    // Pattern neighbours of order[k] among order[k + 1..]
+    std::vector<int> numLaterNeighbours;
+    // domains[u * wordsPerRow..] = target vertices the pattern vertex u may map onto
+    std::vector<BitsetWord> domains;
+
+    std::vector<int> mapping;
+    std::vector<BitsetWord> unused;
+    // One candidate bitset per depth
+    std::vector<BitsetWord> candidates;
+};
+
+template <typename Multigraph>
+std::vector<int> subgraphIsomorphismMatrix(const Multigraph& multigraph) {
+    int numVertices = multigraph.size();
+    std::vector<int> matrix((size_t)numVertices * numVertices);
+    for (int u = 0; u < numVertices; u++) {
+        for (int v = 0; v < numVertices; v++) {
+            matrix[(size_t)u * numVertices + v] = u == v ? multigraph[u][u] : edgeMultiplicity(multigraph, u, v);
+        }
+    }
+    return matrix;
+}
+
+// Degree, neighbour count and largest multiplicity of every vertex, self-loops excluded
+void subgraphIsomorphismVertexInvariants(const std::vector<int>& matrix, int numVertices, std::vector<int>& degrees, std::vector<int>& numNeighbours, std::vector<int>& maxMultiplicities) {
+    degrees.assign(numVertices, 0);
+    numNeighbours.assign(numVertices, 0);
+    maxMultiplicities.assign(numVertices, 0);
+    for (int u = 0; u < numVertices; u++) {
+        for (int v = 0; v < numVertices; v++) {
+            int multiplicity = matrix[(size_t)u * numVertices + v];
+            if (u != v && multiplicity > 0) {
+                degrees[u] += multiplicity;
+                numNeighbours[u]++;
+                maxMultiplicities[u] = std::max(maxMultiplicities[u], multiplicity);
+            }
+        }
+    }
+}
+
+void subgraphIsomorphismOrder(SubgraphIsomorphismSearch& search, const std::vector<int>& degrees) {
+    // Time complexity: O(P^2)
+
+    int numPatternVertices = search.numPatternVertices;
+    const std::vector<int>& pattern = search.pattern;
+
+    std::vector<int> rarity(numPatternVertices);
+    for (int u = 0; u < numPatternVertices; u++) {
+        rarity[u] = bitsetCount(&search.domains[(size_t)u * search.wordsPerRow], search.wordsPerRow);
+    }
+
+    std::vector<char> isOrdered(numPatternVertices, 0);
+    std::vector<int> numOrderedNeighbours(numPatternVertices, 0);
+
+    auto addToOrder = [&](int u) {
+        search.order.push_back(u);
+        isOrdered[u] = 1;
+        for (int w = 0; w < numPatternVertices; w++) {
+            if (w != u && pattern[(size_t)u * numPatternVertices + w] > 0) {
+                numOrderedNeighbours[w]++;
+            }
+        }
+    };
+
+    while ((int)search.order.size() < numPatternVertices) {
+        // Root of the next connected component: the rarest domain, then the largest degree
+        int root = -1;
+        for (int u = 0; u < numPatternVertices; u++) {
+            if (!isOrdered[u] && (root == -1 || rarity[u] < rarity[root] || (rarity[u] == rarity[root] && degrees[u] > degrees[root]))) {
+                root = u;
+            }
+        }
+
+        std::vector<int> level = {root};
+        std::vector<char> isQueued(numPatternVertices, 0);
+        isQueued[root] = 1;
+
+        while (!level.empty()) {
+            std::vector<int> nextLevel;
+
+            // The level is ordered greedily: most connected to the ordered vertices, then rarest, then largest degree
+            while (!level.empty()) {
+                auto best = level.begin();
+                for (auto it = level.begin(); it != level.end(); ++it) {
+                    int u = *it;
+                    int b = *best;
+                    if (numOrderedNeighbours[u] != numOrderedNeighbours[b]) {
+                        if (numOrderedNeighbours[u] > numOrderedNeighbours[b]) {
+                            best = it;
+                        }
+                    } else if (rarity[u] != rarity[b]) {
+                        if (rarity[u] < rarity[b]) {
+                            best = it;
+                        }
+                    } else if (degrees[u] > degrees[b]) {
+                        best = it;
+                    }
+                }
+
+                int u = *best;
+                level.erase(best);
+                addToOrder(u);
+
+                for (int w = 0; w < numPatternVertices; w++) {
+                    if (w != u && !isQueued[w] && pattern[(size_t)u * numPatternVertices + w] > 0) {
+                        isQueued[w] = 1;
+                        nextLevel.push_back(w);
+                    }
+                }
+            }
+
+            level = std::move(nextLevel);
+        }
+    }
+
+    search.earlierNeighbours.assign(numPatternVertices, {});
+    search.earlierNonNeighbours.assign(numPatternVertices, {});
+    search.numLaterNeighbours.assign(numPatternVertices, 0);
+    for (int k = 0; k < numPatternVertices; k++) {
+        int u = search.order[k];
+        for (int l = 0; l < numPatternVertices; l++) {
+            if (l == k) {
+                continue;
+            }
+            int w = search.order[l];
+            bool isNeighbour = pattern[(size_t)u * numPatternVertices + w] > 0;
+            if (l < k) {
+                (isNeighbour ? search.earlierNeighbours[k] : search.earlierNonNeighbours[k]).push_back(w);
+            } else if (isNeighbour) {
+                search.numLaterNeighbours[k]++;
+            }
+        }
+    }
+}
+
+template <typename Visitor>
+bool subgraphIsomorphismHelper(SubgraphIsomorphismSearch& search, int depth, Visitor& visit) {
+    if (depth == search.numPatternVertices) {
+        return visit((const std::vector<int>&)search.mapping);
+    }
+
+    int wordsPerRow = search.wordsPerRow;
+    int numPatternVertices = search.numPatternVertices;
+    int numTargetVertices = search.numTargetVertices;
+    bool isExact = search.mode == SubgraphMatchMode::Exact;
+    int u = search.order[depth];
+
+    BitsetWord* candidates = &search.candidates[(size_t)depth * wordsPerRow];
+    bitsetIntersect(candidates, &search.domains[(size_t)u * wordsPerRow], search.unused.data(), wordsPerRow);
+    for (int w : search.earlierNeighbours[depth]) {
+        bitsetIntersect(candidates, candidates, search.targetAdjacency[search.mapping[w]], wordsPerRow);
+    }
+    if (isExact) {
+        for (int w : search.earlierNonNeighbours[depth]) {
+            bitsetDifference(candidates, candidates, search.targetAdjacency[search.mapping[w]], wordsPerRow);
+        }
+    }
+
+    const int* patternRow = &search.pattern[(size_t)u * numPatternVertices];
+
+    for (int k = 0; k < wordsPerRow; k++) {
+        BitsetWord word = candidates[k];
+        while (word) {
+            int t = k * bitsetWordSize + countTrailingZeros64(word);
+            word &= word - 1;
+
+            const int* targetRow = &search.target[(size_t)t * numTargetVertices];
+            bool isFeasible = true;
+            for (int w : search.earlierNeighbours[depth]) {
+                int patternMultiplicity = patternRow[w];
+                int targetMultiplicity = targetRow[search.mapping[w]];
+                if (isExact ? patternMultiplicity != targetMultiplicity : patternMultiplicity > targetMultiplicity) {
+                    isFeasible = false;
+                    break;
+                }
+            }
+            if (!isFeasible || bitsetCountIntersection(search.targetAdjacency[t], search.unused.data(), wordsPerRow) < search.numLaterNeighbours[depth]) {
+                continue;
+            }
+
+            search.mapping[u] = t;
+            bitsetReset(search.unused.data(), t);
+            bool shouldContinue = subgraphIsomorphismHelper(search, depth + 1, visit);
+            bitsetSet(search.unused.data(), t);
+            search.mapping[u] = -1;
+
+            if (!shouldContinue) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Calls visit(mapping) for every embedding, mapping[u] is the target vertex of the pattern vertex u.
+// visit returns false to stop, forEachSubgraphEmbedding then returns false too.
+template <typename Multigraph, typename Visitor>
+bool forEachSubgraphEmbedding(const Multigraph& pattern, const Multigraph& target, SubgraphMatchMode mode, Visitor visit) {
+    // Time complexity: O(T^P) in the worst case, O(P * T / 64) bitset work per search node
+    // Space complexity: O(P^2 + T^2)
+
+    SubgraphIsomorphismSearch search;
+    search.mode = mode;
+    search.numPatternVertices = pattern.size();
+    search.numTargetVertices = target.size();
+
+    int numPatternVertices = search.numPatternVertices;
+    int numTargetVertices = search.numTargetVertices;
+    if (numPatternVertices > numTargetVertices) {
+        return true;
+    }
+    if (numPatternVertices == 0) {
+        std::vector<int> emptyMapping;
+        return visit((const std::vector<int>&)emptyMapping);
+    }
+
+    search.pattern = subgraphIsomorphismMatrix(pattern);
+    search.target = subgraphIsomorphismMatrix(target);
+    search.targetAdjacency = makeBitsetAdjacency(target);
+    search.wordsPerRow = search.targetAdjacency.wordsPerRow;
+    int wordsPerRow = search.wordsPerRow;
+
+    std::vector<int> patternDegrees, patternNumNeighbours, patternMaxMultiplicities;
+    std::vector<int> targetDegrees, targetNumNeighbours, targetMaxMultiplicities;
+    subgraphIsomorphismVertexInvariants(search.pattern, numPatternVertices, patternDegrees, patternNumNeighbours, patternMaxMultiplicities);
+    subgraphIsomorphismVertexInvariants(search.target, numTargetVertices, targetDegrees, targetNumNeighbours, targetMaxMultiplicities);
+
+    search.domains.assign((size_t)numPatternVertices * wordsPerRow, 0);
+    for (int u = 0; u < numPatternVertices; u++) {
+        int patternSelfLoops = search.pattern[(size_t)u * numPatternVertices + u];
+        for (int t = 0; t < numTargetVertices; t++) {
+            int targetSelfLoops = search.target[(size_t)t * numTargetVertices + t];
+            bool isSelfLoopCompatible = mode == SubgraphMatchMode::Exact ? patternSelfLoops == targetSelfLoops : patternSelfLoops <= targetSelfLoops;
+            if (
+                isSelfLoopCompatible
+                && patternDegrees[u] <= targetDegrees[t]
+                && patternNumNeighbours[u] <= targetNumNeighbours[t]
+                && patternMaxMultiplicities[u] <= targetMaxMultiplicities[t]
+            ) {
+                bitsetSet(&search.domains[(size_t)u * wordsPerRow], t);
+            }
+        }
+    }
+
+    subgraphIsomorphismOrder(search, patternDegrees);
+
+    search.mapping.assign(numPatternVertices, -1);
+    search.unused.assign(wordsPerRow, 0);
+    for (int t = 0; t < numTargetVertices; t++) {
+        bitsetSet(search.unused.data(), t);
+    }
+    search.candidates.assign((size_t)numPatternVertices * wordsPerRow, 0);
+
+    return subgraphIsomorphismHelper(search, 0, visit);
+}
+
+struct SubgraphIsomorphismResult {
+    long long numEmbeddings;
+    // maxEmbeddings was reached before the search space was exhausted
+    bool hasReachedLimit;
+    // The first embedding found, empty when there is none
+    std::vector<int> mapping;
+};
+
+// Counts the embeddings, stopping after maxEmbeddings of them (0 for no limit)
+template <typename Multigraph>
+SubgraphIsomorphismResult findSubgraphEmbeddings(const Multigraph& pattern, const Multigraph& target, SubgraphMatchMode mode, long long maxEmbeddings) {
+    SubgraphIsomorphismResult result = {0, false, {}};
+
+    bool isComplete = forEachSubgraphEmbedding(pattern, target, mode, [&result, maxEmbeddings](const std::vector<int>& mapping) {
+        if (result.numEmbeddings == 0) {
+            result.mapping = mapping;
+        }
+        result.numEmbeddings++;
+        return maxEmbeddings <= 0 || result.numEmbeddings < maxEmbeddings;
+    });
+    result.hasReachedLimit = !isComplete;
+
+    return result;
+}
+
+#endif //AAC_LABORATORIES_SUBGRAPH_ISOMORPHISM_H
@@ -0,0 +1,131 @@
+#include <vector>
+#include <cstdint>
+
+#include "bitset_adjacency.h"
+
+#ifndef AAC_LABORATORIES_SUBSET_ENUMERATION_H
+#define AAC_LABORATORIES_SUBSET_ENUMERATION_H
+
+// Allocation-free enumeration of the subsets of {0, ..., numElements - 1} with a fixed number of elements.
+// Only O(numElements) state is kept, the subsets are streamed to a visitor one by one, and the visitor returns false to stop.
+
+// Subsets as sorted index lists in lexicographic order: {0, 1, 2}, {0, 1, 3}, ..., {n - 3, n - 2, n - 1}.
+// This is the order in which a recursive "take the next element or not" enumeration emits the subsets of one size.
+template <typename Visitor>
+bool forEachCombination(int numElements, int subsetSize, Visitor visit) {
+    // Time complexity: O(C(numElements, subsetSize)) steps, O(subsetSize) each in the worst case
+
+    if (subsetSize > numElements) {
+        return true;
+    }
+
+    std::vector<int> combination(subsetSize);
+    for (int i = 0; i < subsetSize; i++) {
+        combination[i] = i;
+    }
+
+    while (true) {
+        if (!visit((const std::vector<int>&)combination)) {
+            return false;
+        }
+
+        // The last element that can still move right, combination[i] can go up to numElements - subsetSize + i
+        int i = subsetSize - 1;
+        while (i >= 0 && combination[i] == numElements - subsetSize + i) {
+            i--;
+        }
+        if (i < 0) {
+            return true;
+        }
+
+        combination[i]++;
+        for (int j = i + 1; j < subsetSize; j++) {
+            combination[j] = combination[j - 1] + 1;
+        }
+    }
+}
+
+// Subsets as bitsets (bit v is set iff v is selected) in decreasing order of the mask read as a binary number,
+// i.e. the subsets containing the highest vertices come first.
+
+// Single 64-bit word, up to 64 elements.
+// Decreasing Gosper's hack: the complement of a subset of size k is a subset of size numElements - k,
+// and stepping the complement to the next larger mask with the same popcount (Gosper's hack)
+// steps the subset to the next smaller one.
+template <typename Visitor>
+bool forEachSubsetOfSizeDescending64(int numElements, int subsetSize, Visitor visit) {
+    // Time complexity: O(C(numElements, subsetSize)) steps, O(1) each
+
+    BitsetWord fullMask = numElements == bitsetWordSize ? ~BitsetWord(0) : (BitsetWord(1) << numElements) - 1;
+    BitsetWord lowestMask = subsetSize == bitsetWordSize ? ~BitsetWord(0) : (BitsetWord(1) << subsetSize) - 1;
+    BitsetWord mask = subsetSize == numElements ? fullMask : fullMask & ~(fullMask >> subsetSize);
+
+    while (true) {
+        if (!visit(&mask)) {
+            return false;
+        }
+        if (mask == lowestMask) {
+            return true;
+        }
+
+        BitsetWord complement = ~mask & fullMask;
+        BitsetWord lowestBit = complement & (~complement + 1);
+        BitsetWord ripple = complement + lowestBit;
+        complement = (((ripple ^ complement) >> 2) / lowestBit) | ripple;
+        mask = ~complement & fullMask;
+    }
+}
+
+// Any number of elements, multi-word mask.
+// The selected elements are kept in decreasing order, elements[i] can go down to subsetSize - 1 - i;
+// the deepest element that can still go down is decremented and the ones after it are packed right below it.
+template <typename Visitor>
+bool forEachSubsetOfSizeDescending(int numElements, int subsetSize, Visitor visit) {
+    // Time complexity: O(C(numElements, subsetSize)) steps, O(subsetSize) each in the worst case
+
+    std::vector<BitsetWord> mask(bitsetNumWords(numElements), 0);
+    std::vector<int> elements(subsetSize);
+    for (int i = 0; i < subsetSize; i++) {
+        elements[i] = numElements - 1 - i;
+        bitsetSet(mask.data(), elements[i]);
+    }
+
+    while (true) {
+        if (!visit((const BitsetWord*)mask.data())) {
+            return false;
+        }
+
+        int i = subsetSize - 1;
+        while (i >= 0 && elements[i] == subsetSize - 1 - i) {
+            i--;
+        }
+        if (i < 0) {
+            return true;
+        }
+
+        for (int j = i; j < subsetSize; j++) {
+            bitsetReset(mask.data(), elements[j]);
+        }
+
+        elements[i]--;
+        for (int j = i + 1; j < subsetSize; j++) {
+            elements[j] = elements[j - 1] - 1;
+        }
+
+        for (int j = i; j < subsetSize; j++) {
+            bitsetSet(mask.data(), elements[j]);
+        }
+    }
+}
+
+// Uses the single word engine whenever the elements fit into it
+template <typename Visitor>
+bool forEachSubsetOfSizeDescendingAnyWidth(int numElements, int subsetSize, Visitor visit) {
+    if (numElements <= bitsetWordSize) {
+        return forEachSubsetOfSizeDescending64(numElements, subsetSize, visit);
+    }
+
+    return forEachSubsetOfSizeDescending(numElements, subsetSize, visit);
+}
+
+#endif //AAC_LABORATORIES_SUBSET_ENUMERATION_H
@@ -0,0 +1,177 @@
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+#ifndef AAC_LABORATORIES_THREAD_POOL_H
+#define AAC_LABORATORIES_THREAD_POOL_H
+
+// Fixed size pool of worker threads with work stealing.
+// Every worker owns a deque: it takes its own tasks from the back (the most recently split, cache-warm work)
+// and, when it runs dry, steals from the front of the other deques (the oldest, usually the biggest pieces of work).
+// Tasks may submit more tasks; those go to the deque of the submitting worker, so recursive splitting stays local.
+class WorkStealingThreadPool {
+public:
+    explicit WorkStealingThreadPool(int threadCount): pendingTasks(0), queuedTasks(0), nextQueue(0), isStopping(false) {
+        if (threadCount < 1) {
+            threadCount = 1;
+        }
+
+        for (int i = 0; i < threadCount; i++) {
+            queues.emplace_back(new WorkerQueue());
+        }
+        for (int i = 0; i < threadCount; i++) {
+            threads.emplace_back(&WorkStealingThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ~WorkStealingThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            isStopping = true;
+        }
+        taskAvailable.notify_all();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    int size() const {
+        return threads.size();
+    }
+
+    void submit(std::function<void()> task) {
+        int queueIndex = currentWorkerIndex() >= 0 && currentWorkerPool() == this
+            ? currentWorkerIndex()
+            : nextQueue++ % queues.size();
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            pendingTasks++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+            queues[queueIndex]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            queuedTasks++;
+        }
+        taskAvailable.notify_one();
+    }
+
+    // Block until every submitted task (including the ones submitted by tasks) has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allTasksDone.wait(lock, [this]() {
+            return pendingTasks == 0;
+        });
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static int& currentWorkerIndex() {
+        static thread_local int workerIndex = -1;
+        return workerIndex;
+    }
+
+    static WorkStealingThreadPool*& currentWorkerPool() {
+        static thread_local WorkStealingThreadPool* workerPool = nullptr;
+        return workerPool;
+    }
+
+    bool tryTakeTask(int workerIndex, std::function<void()>& task) {
+        // Own deque, newest first
+        {
+            WorkerQueue& queue = *queues[workerIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+
+        // Steal from the others, oldest first
+        for (int offset = 1; offset < (int)queues.size(); offset++) {
+            WorkerQueue& queue = *queues[(workerIndex + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void workerLoop(int workerIndex) {
+        currentWorkerIndex() = workerIndex;
+        currentWorkerPool() = this;
+
+        while (true) {
+            std::function<void()> task;
+
+            if (tryTakeTask(workerIndex, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    queuedTasks--;
+                }
+
+                task();
+
+                bool isLastTask;
+                {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    isLastTask = --pendingTasks == 0;
+                }
+                if (isLastTask) {
+                    allTasksDone.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(stateMutex);
+            taskAvailable.wait(lock, [this]() {
+                return isStopping || queuedTasks > 0;
+            });
+            if (isStopping && queuedTasks <= 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allTasksDone;
+    // Submitted and not finished / submitted and not taken by a worker yet
+    int pendingTasks;
+    int queuedTasks;
+    std::atomic<unsigned int> nextQueue;
+    bool isStopping;
+};
+
+// Lower the shared value to candidate if it is smaller
+void atomicMin(std::atomic<int>& value, int candidate) {
+    int current = value.load();
+    while (candidate < current && !value.compare_exchange_weak(current, candidate)) {
+    }
+}
+
+#endif //AAC_LABORATORIES_THREAD_POOL_H